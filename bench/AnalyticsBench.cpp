@@ -0,0 +1,32 @@
+#include "BenchUtil.h"
+#include "../src/analytics/RaceAnalytics.h"
+#include "../src/telemetry/TelemetryGenerator.h"
+#include <benchmark/benchmark.h>
+
+// Per-frame cost of the analytics stage over a recorded 20-car stream, so lap,
+// sector and pit transitions occur at their natural rate.
+static void BM_RaceAnalytics_ProcessFrame(benchmark::State& state) {
+    const auto& track = BenchUtil::defaultTrack();
+    auto penalty_enforcer = std::make_shared<PenaltyEnforcer>(SeasonData::builtin()->drivers().size());
+    TelemetryGenerator generator(track, SeasonData::builtin(), 10, penalty_enforcer);
+
+    std::vector<TelemetryFrame> tick(generator.driverCount());
+    std::vector<TelemetryFrame> recorded;
+    while(!generator.isRaceFinished()) {
+        generator.next(tick);
+        recorded.insert(recorded.end(), tick.begin(), tick.end());
+    }
+
+    for(auto _ : state) {
+        state.PauseTiming();
+        RaceAnalytics analytics(generator.driverCount(), track.sectors);
+        state.ResumeTiming();
+
+        for(const auto& frame : recorded) {
+            analytics.processFrame(frame);
+        }
+        benchmark::DoNotOptimize(analytics.lapTimes(0));
+    }
+    state.SetItemsProcessed(state.iterations() * recorded.size());
+}
+BENCHMARK(BM_RaceAnalytics_ProcessFrame)->Unit(benchmark::kMillisecond);
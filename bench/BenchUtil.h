@@ -0,0 +1,44 @@
+#pragma once
+
+#include "../src/common/types.h"
+#include "../src/data/season_data.h"
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+
+namespace BenchUtil {
+    // Fixed seed for every randomized component so runs are comparable across releases.
+    constexpr uint32_t SEED = 42;
+
+    // Heap allocations made by the calling thread (counted by the operator new
+    // replacement in bench_main.cpp).
+    uint64_t threadAllocations();
+
+    // Pins the calling thread to one CPU, wrapping around the available cores.
+    inline void pinCurrentThread(unsigned index) {
+        const unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(index % cpus, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+
+    inline const TrackProfile& defaultTrack() {
+        return SeasonData::builtin()->tracks()[0];
+    }
+
+    // Grid of `size` entries over the unmodified season profiles, split evenly
+    // into `classes` car classes.
+    inline std::vector<GridEntry> makeGrid(size_t size, uint8_t classes = 1) {
+        std::vector<GridEntry> grid(size);
+        for(size_t i = 0; i < size; i++) {
+            grid[i].driver_index = static_cast<uint32_t>(i % SeasonData::builtin()->drivers().size());
+            grid[i].car_index = static_cast<uint32_t>(i % SeasonData::builtin()->cars().size());
+            grid[i].car_class = static_cast<uint8_t>(i * classes / size);
+        }
+        return grid;
+    }
+}
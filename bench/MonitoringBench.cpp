@@ -0,0 +1,58 @@
+#include "BenchUtil.h"
+#include "../src/monitoring/Instrumentation.h"
+#include "../src/monitoring/MetricsRegistry.h"
+#include <benchmark/benchmark.h>
+
+// Instrumentation cost for one 20-car tick as the live pipeline pays it: generation
+// stamp, push stamps and occupancy-free pop/processed hooks for every frame.
+// Reported per frame. Compiles to an empty loop without F1_INSTRUMENTATION.
+static void BM_Instrumentation_PerFrame(benchmark::State& state) {
+    PipelineStats stats;
+    std::vector<TelemetryFrame> frames(SeasonData::builtin()->drivers().size());
+    uint64_t tick = 0;
+
+    for(auto _ : state) {
+        Instrumentation::stampGenerated(frames, tick++);
+        const uint64_t pushed_at = Instrumentation::now();
+        for(auto& frame : frames) {
+            Instrumentation::onPush(stats, frame, pushed_at);
+        }
+        for(const auto& frame : frames) {
+            const uint64_t popped_at = Instrumentation::onPop(stats, frame);
+            Instrumentation::onProcessed(stats, frame, popped_at);
+        }
+        benchmark::DoNotOptimize(frames.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * frames.size());
+    state.counters["ns_per_frame"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * frames.size()),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    if(!Instrumentation::ENABLED) {
+        state.SetLabel("instrumentation compiled out");
+    }
+}
+BENCHMARK(BM_Instrumentation_PerFrame);
+
+static void BM_LatencyHistogram_Record(benchmark::State& state) {
+    LatencyHistogram histogram;
+    uint64_t value = 1;
+
+    for(auto _ : state) {
+        histogram.record(value);
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL; // LCG spread over all buckets
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LatencyHistogram_Record);
+
+// Hot-path counter update: one relaxed store to the calling thread's own block.
+static void BM_Metrics_Increment(benchmark::State& state) {
+    BenchUtil::pinCurrentThread(static_cast<unsigned>(state.thread_index()));
+
+    for(auto _ : state) {
+        Metrics::increment(Counter::FRAMES_PUSHED);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Metrics_Increment)->ThreadRange(1, 8)->UseRealTime();
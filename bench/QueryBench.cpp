@@ -0,0 +1,100 @@
+#include "BenchUtil.h"
+#include "../src/query/QueryEngine.h"
+#include "../src/telemetry/TelemetryGenerator.h"
+#include <benchmark/benchmark.h>
+#include <map>
+
+namespace {
+
+// One full 52-lap, 20-car race, recorded both as frames and as a columnar table.
+struct RecordedRace {
+    std::vector<TelemetryFrame> frames;
+    TelemetryTable table;
+};
+
+const RecordedRace& recordedRace() {
+    static const RecordedRace race = []() {
+        RecordedRace r;
+        auto penalty_enforcer = std::make_shared<PenaltyEnforcer>(SeasonData::builtin()->drivers().size());
+        TelemetryGenerator generator(BenchUtil::defaultTrack(), SeasonData::builtin(), 52, penalty_enforcer);
+        std::vector<TelemetryFrame> tick(generator.driverCount());
+        while(!generator.isRaceFinished()) {
+            generator.next(tick);
+            r.frames.insert(r.frames.end(), tick.begin(), tick.end());
+        }
+        r.table.append(r.frames);
+        return r;
+    }();
+    return race;
+}
+
+const Query MAX_SPEED_PER_DRIVER_LAP = {{}, Aggregate::MAX, Column::SPEED, GroupBy::DRIVER_LAP};
+const Query WORN_AND_FAST = {
+    {{Column::TIRE_WEAR, CompareOp::GT, 0.7f}, {Column::SPEED, CompareOp::GT, 200.0f}},
+    Aggregate::COUNT, Column::SPEED, GroupBy::NONE};
+const Query MEAN_TEMP_BY_SECTOR = {{}, Aggregate::MEAN, Column::TIRE_TEMP_FL, GroupBy::SECTOR};
+
+const Query& queryFor(int64_t index) {
+    switch(index) {
+        case 0: return MAX_SPEED_PER_DRIVER_LAP;
+        case 1: return WORN_AND_FAST;
+        default: return MEAN_TEMP_BY_SECTOR;
+    }
+}
+
+} // namespace
+
+// Arg 0: max speed per driver per lap. Arg 1: count(tire_wear > 0.7 AND speed > 200).
+// Arg 2: mean FL tire temperature by sector. Second arg is thread count.
+static void BM_QueryEngine_Run(benchmark::State& state) {
+    const auto& race = recordedRace();
+    const Query& query = queryFor(state.range(0));
+    const size_t threads = static_cast<size_t>(state.range(1));
+    QueryEngine engine(threads > 1 ? std::make_shared<ForkJoinPool>(threads - 1) : nullptr);
+
+    QueryResult result = {};
+    for(auto _ : state) {
+        result = engine.run(race.table, query);
+        benchmark::DoNotOptimize(result.groups.data());
+    }
+    state.SetItemsProcessed(state.iterations() * race.table.rowCount());
+    state.counters["groups"] = static_cast<double>(result.groups.size());
+    state.counters["chunks_skipped"] = static_cast<double>(result.chunks_skipped);
+}
+BENCHMARK(BM_QueryEngine_Run)->ArgsProduct({{0, 1, 2}, {1, 4}})->UseRealTime();
+
+// The same three queries written as a row-by-row loop over the recorded frames.
+static void BM_QueryEngine_NaiveBaseline(benchmark::State& state) {
+    const auto& race = recordedRace();
+    const int64_t query = state.range(0);
+
+    size_t groups = 0;
+    for(auto _ : state) {
+        if(query == 0) {
+            std::map<std::pair<uint32_t, uint32_t>, float> max_speed;
+            for(const auto& f : race.frames) {
+                auto [it, inserted] = max_speed.try_emplace({f.driver_id, f.lap}, f.speed_kph);
+                if(!inserted && f.speed_kph > it->second) it->second = f.speed_kph;
+            }
+            groups = max_speed.size();
+        } else if(query == 1) {
+            uint64_t count = 0;
+            for(const auto& f : race.frames) {
+                if(f.tire_wear > 0.7f && f.speed_kph > 200.0f) count++;
+            }
+            benchmark::DoNotOptimize(count);
+            groups = 1;
+        } else {
+            std::map<uint32_t, std::pair<double, uint64_t>> temp;
+            for(const auto& f : race.frames) {
+                auto& t = temp[f.sector];
+                t.first += f.tire_temp_c[0];
+                t.second++;
+            }
+            groups = temp.size();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * race.frames.size());
+    state.counters["groups"] = static_cast<double>(groups);
+}
+BENCHMARK(BM_QueryEngine_NaiveBaseline)->DenseRange(0, 2)->UseRealTime();
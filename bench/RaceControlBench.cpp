@@ -0,0 +1,63 @@
+#include "BenchUtil.h"
+#include "../src/race-control/TrackLimitsMonitor.h"
+#include "../src/race-control/PenaltyEnforcer.h"
+#include <benchmark/benchmark.h>
+
+// Every frame enters a new sector, so each call runs the full violation check.
+static void BM_TrackLimitsMonitor_ProcessFrame_SectorChange(benchmark::State& state) {
+    auto penalty_enforcer = std::make_shared<PenaltyEnforcer>(SeasonData::builtin()->drivers().size());
+    TrackLimitsMonitor monitor(BenchUtil::defaultTrack(), SeasonData::builtin(), penalty_enforcer, BenchUtil::SEED);
+
+    TelemetryFrame frame{};
+    frame.speed_kph = 210.0f;
+    frame.tire_wear = 0.3f;
+    uint64_t n = 0;
+
+    for(auto _ : state) {
+        frame.driver_id = static_cast<uint32_t>(n % SeasonData::builtin()->drivers().size());
+        frame.sector = static_cast<uint8_t>(1 + (n / SeasonData::builtin()->drivers().size()) % 3);
+        monitor.processFrame(frame);
+        n++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TrackLimitsMonitor_ProcessFrame_SectorChange);
+
+// Frames within a sector: the common case, which should exit early.
+static void BM_TrackLimitsMonitor_ProcessFrame_SameSector(benchmark::State& state) {
+    auto penalty_enforcer = std::make_shared<PenaltyEnforcer>(SeasonData::builtin()->drivers().size());
+    TrackLimitsMonitor monitor(BenchUtil::defaultTrack(), SeasonData::builtin(), penalty_enforcer, BenchUtil::SEED);
+
+    TelemetryFrame frame{};
+    frame.sector = 1;
+    uint64_t n = 0;
+
+    for(auto _ : state) {
+        frame.driver_id = static_cast<uint32_t>(n % SeasonData::builtin()->drivers().size());
+        monitor.processFrame(frame);
+        n++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TrackLimitsMonitor_ProcessFrame_SameSector);
+
+// Producer-side (shouldServe/isComplete) and display-side (getPenaltyInfo) lookups
+// hammering the same enforcer from several pinned threads.
+static void BM_PenaltyEnforcer_Lookup(benchmark::State& state) {
+    static PenaltyEnforcer enforcer(SeasonData::builtin()->drivers().size());
+    BenchUtil::pinCurrentThread(static_cast<unsigned>(state.thread_index()));
+
+    const uint32_t drivers = static_cast<uint32_t>(SeasonData::builtin()->drivers().size());
+    uint32_t driver_id = static_cast<uint32_t>(state.thread_index()) % drivers;
+    uint64_t now_ns = 0;
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(enforcer.shouldServePenalty(driver_id, now_ns));
+        benchmark::DoNotOptimize(enforcer.isPenaltyComplete(driver_id, now_ns));
+        benchmark::DoNotOptimize(enforcer.getPenaltyInfo(driver_id));
+        driver_id = (driver_id + 1) % drivers;
+        now_ns += 20'000'000ULL;
+    }
+    state.SetItemsProcessed(state.iterations() * 3);
+}
+BENCHMARK(BM_PenaltyEnforcer_Lookup)->ThreadRange(1, 8)->UseRealTime();
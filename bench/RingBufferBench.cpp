@@ -0,0 +1,122 @@
+#include "BenchUtil.h"
+#include "../src/ingestion/RingBuffer.h"
+#include "../src/ingestion/AsyncRingBuffer.h"
+#include <benchmark/benchmark.h>
+
+// Uncontended push followed by pop on the same thread.
+static void BM_RingBuffer_PushPop(benchmark::State& state) {
+    RingBuffer<TelemetryFrame> buffer(1024);
+    TelemetryFrame in{};
+    TelemetryFrame out{};
+
+    for(auto _ : state) {
+        buffer.push(in);
+        buffer.pop(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingBuffer_PushPop);
+
+// Producer/consumer pairs sharing one buffer: even thread indices push, odd ones pop.
+// Every thread runs the same iteration count, so pairs stay balanced and no pop is left waiting.
+static void BM_RingBuffer_Contended(benchmark::State& state) {
+    static RingBuffer<TelemetryFrame> buffer(1024);
+    BenchUtil::pinCurrentThread(static_cast<unsigned>(state.thread_index()));
+
+    const bool producer = (state.thread_index() % 2 == 0);
+    TelemetryFrame frame{};
+
+    for(auto _ : state) {
+        if(producer) {
+            while(!buffer.push(frame)) {
+                std::this_thread::yield();
+            }
+        } else {
+            buffer.pop(frame);
+            benchmark::DoNotOptimize(frame);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingBuffer_Contended)->Threads(2)->Threads(4)->Threads(8)->UseRealTime();
+
+namespace {
+
+constexpr size_t PIPELINE_FRAMES = 4096;
+
+Task benchProducer(AsyncRingBuffer<TelemetryFrame>& out) {
+    TelemetryFrame frame{};
+    for(size_t i = 0; i < PIPELINE_FRAMES; i++) {
+        frame.lap = static_cast<uint32_t>(i);
+        co_await out.push(frame);
+    }
+    out.close();
+}
+
+Task benchForward(AsyncRingBuffer<TelemetryFrame>& in, AsyncRingBuffer<TelemetryFrame>& out) {
+    TelemetryFrame frame;
+    while(co_await in.pop(frame)) {
+        co_await out.push(frame);
+    }
+    out.close();
+}
+
+Task benchSink(AsyncRingBuffer<TelemetryFrame>& in, uint64_t& sum) {
+    TelemetryFrame frame;
+    while(co_await in.pop(frame)) {
+        sum += frame.lap;
+    }
+}
+
+} // namespace
+
+// Three-stage pipeline (source -> forward -> sink) as coroutines on an executor with
+// range(0) threads, versus the same pipeline as one blocking thread per stage below.
+static void BM_AsyncRingBuffer_Pipeline(benchmark::State& state) {
+    uint64_t sum = 0;
+    for(auto _ : state) {
+        Executor executor(static_cast<size_t>(state.range(0)));
+        AsyncRingBuffer<TelemetryFrame> a(256, executor);
+        AsyncRingBuffer<TelemetryFrame> b(256, executor);
+        executor.spawn(benchProducer(a));
+        executor.spawn(benchForward(a, b));
+        executor.spawn(benchSink(b, sum));
+        executor.run();
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * PIPELINE_FRAMES);
+}
+BENCHMARK(BM_AsyncRingBuffer_Pipeline)->Arg(1)->Arg(2)->UseRealTime();
+
+static void BM_RingBuffer_ThreadPipeline(benchmark::State& state) {
+    uint64_t sum = 0;
+    for(auto _ : state) {
+        RingBuffer<TelemetryFrame> a(256);
+        RingBuffer<TelemetryFrame> b(256);
+        std::thread source([&]() {
+            TelemetryFrame frame{};
+            for(size_t i = 0; i < PIPELINE_FRAMES; i++) {
+                frame.lap = static_cast<uint32_t>(i);
+                while(!a.push(frame)) std::this_thread::yield();
+            }
+            a.shutdown();
+        });
+        std::thread forward([&]() {
+            TelemetryFrame frame;
+            while(a.pop(frame)) {
+                while(!b.push(frame)) std::this_thread::yield();
+            }
+            b.shutdown();
+        });
+        TelemetryFrame frame;
+        while(b.pop(frame)) {
+            sum += frame.lap;
+        }
+        source.join();
+        forward.join();
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * PIPELINE_FRAMES);
+}
+BENCHMARK(BM_RingBuffer_ThreadPipeline)->UseRealTime();
@@ -0,0 +1,114 @@
+#include "BenchUtil.h"
+#include "../src/strategy/RaceSimulator.h"
+#include "../src/strategy/StrategyAnalyzer.h"
+#include <benchmark/benchmark.h>
+
+// Full 52-lap strategy simulation for one candidate pit lap.
+static void BM_RaceSimulator_SimulateRace(benchmark::State& state) {
+    const uint32_t pit_lap = static_cast<uint32_t>(state.range(0));
+    RaceSimulator simulator(BenchUtil::defaultTrack(), SeasonData::builtin(), 52);
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(simulator.simulateRace(4, pit_lap));
+    }
+}
+BENCHMARK(BM_RaceSimulator_SimulateRace)->Arg(12)->Arg(24)->Arg(36)->Unit(benchmark::kMillisecond);
+
+// Pit-lap search for three drivers, varying how many simulations run concurrently.
+// The analyzer (and its stint cache) is rebuilt outside the timed region for every
+// search, so each one simulates its stints rather than replaying the last search's.
+static void BM_StrategyAnalyzer_AnalyzeStrategies(benchmark::State& state) {
+    const uint32_t threads = static_cast<uint32_t>(state.range(0));
+    const std::vector<uint32_t> driver_ids = {1, 4, 6};
+
+    for(auto _ : state) {
+        state.PauseTiming();
+        StrategyAnalyzer analyzer(BenchUtil::defaultTrack(), SeasonData::builtin(), 52, threads);
+        state.ResumeTiming();
+        auto results = analyzer.analyzeStrategies(driver_ids);
+        benchmark::DoNotOptimize(results.data());
+    }
+}
+BENCHMARK(BM_StrategyAnalyzer_AnalyzeStrategies)
+    ->Arg(1)->Arg(2)->Arg(4)->Arg(10)
+    ->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// simulateRace() composed from cached stints. Arg 1 = warm: the cache already holds
+// every stint; Arg 0 = cold: a fresh cache per iteration, so the two stints are
+// simulated lap by lap once (the uncached baseline is BM_RaceSimulator_SimulateRace).
+static void BM_RaceSimulator_SimulateRace_StintCache(benchmark::State& state) {
+    const uint32_t pit_lap = static_cast<uint32_t>(state.range(0));
+    const bool warm = state.range(1) != 0;
+    auto cache = std::make_shared<StintCache>();
+
+    for(auto _ : state) {
+        if(!warm) {
+            state.PauseTiming();
+            cache = std::make_shared<StintCache>();
+            state.ResumeTiming();
+        }
+        RaceSimulator simulator(BenchUtil::defaultTrack(), SeasonData::builtin(), 52, cache);
+        benchmark::DoNotOptimize(simulator.simulateRace(4, pit_lap));
+    }
+    state.counters["hit_rate"] = cache->stats().hitRate();
+}
+BENCHMARK(BM_RaceSimulator_SimulateRace_StintCache)
+    ->Args({24, 0})->Args({24, 1})->Unit(benchmark::kMicrosecond);
+
+// One cold pit-lap search: a new analyzer (and stint cache) per iteration, so no
+// stints carry over between iterations, only between candidates and workers.
+static void BM_StrategyAnalyzer_AnalyzeStrategies_Cold(benchmark::State& state) {
+    const uint32_t threads = static_cast<uint32_t>(state.range(0));
+    const std::vector<uint32_t> driver_ids = {1, 4, 6};
+    double hit_rate = 0.0;
+
+    for(auto _ : state) {
+        StrategyAnalyzer analyzer(BenchUtil::defaultTrack(), SeasonData::builtin(), 52, threads);
+        auto results = analyzer.analyzeStrategies(driver_ids);
+        benchmark::DoNotOptimize(results.data());
+        hit_rate = analyzer.stintCacheStats().hitRate();
+    }
+    state.counters["hit_rate"] = hit_rate;
+}
+BENCHMARK(BM_StrategyAnalyzer_AnalyzeStrategies_Cold)
+    ->Arg(1)->Arg(4)
+    ->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Repeated pit-lap search on one analyzer: after the first iteration every stint is
+// already cached, so this is the cost of composing races from cache hits.
+static void BM_StrategyAnalyzer_AnalyzeStrategies_Warm(benchmark::State& state) {
+    const uint32_t threads = static_cast<uint32_t>(state.range(0));
+    StrategyAnalyzer analyzer(BenchUtil::defaultTrack(), SeasonData::builtin(), 52, threads);
+    const std::vector<uint32_t> driver_ids = {1, 4, 6};
+
+    for(auto _ : state) {
+        auto results = analyzer.analyzeStrategies(driver_ids);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.counters["hit_rate"] = analyzer.stintCacheStats().hitRate();
+}
+BENCHMARK(BM_StrategyAnalyzer_AnalyzeStrategies_Warm)
+    ->Arg(1)->Arg(4)
+    ->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Joint best-response search for 2 drivers and the full 20-car grid, with a fresh
+// analyzer per iteration so no races carry over between iterations.
+static void BM_StrategyAnalyzer_AnalyzeJoint(benchmark::State& state) {
+    const uint32_t drivers = static_cast<uint32_t>(state.range(0));
+    std::vector<uint32_t> driver_ids;
+    for(uint32_t i = 0; i < drivers; i++) {
+        driver_ids.push_back(i);
+    }
+    JointStrategyResult result{};
+
+    for(auto _ : state) {
+        StrategyAnalyzer analyzer(BenchUtil::defaultTrack(), SeasonData::builtin(), 52);
+        result = analyzer.analyzeJointStrategies(driver_ids);
+        benchmark::DoNotOptimize(result.results.data());
+    }
+    state.counters["rounds"] = result.rounds;
+    state.counters["races"] = static_cast<double>(result.races_simulated);
+}
+BENCHMARK(BM_StrategyAnalyzer_AnalyzeJoint)
+    ->Arg(2)->Arg(20)
+    ->UseRealTime()->Unit(benchmark::kMillisecond);
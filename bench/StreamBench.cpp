@@ -0,0 +1,42 @@
+#include "BenchUtil.h"
+#include "../src/streams/TierDecimator.h"
+#include "../src/telemetry/TelemetryGenerator.h"
+#include <benchmark/benchmark.h>
+
+// Per-frame cost of computing every stream tier over a recorded 20-car stream, with
+// each tier's share of the raw stream in bytes (10 Hz frames, sector events and lap
+// summaries against the full-rate frames).
+static void BM_TierDecimator_Process(benchmark::State& state) {
+    const auto& track = BenchUtil::defaultTrack();
+    auto penalty_enforcer = std::make_shared<PenaltyEnforcer>(SeasonData::builtin()->drivers().size());
+    TelemetryGenerator generator(track, SeasonData::builtin(), 10, penalty_enforcer);
+
+    std::vector<TelemetryFrame> tick(generator.driverCount());
+    std::vector<TelemetryFrame> recorded;
+    while(!generator.isRaceFinished()) {
+        generator.next(tick);
+        recorded.insert(recorded.end(), tick.begin(), tick.end());
+    }
+
+    SectorEvent sector;
+    LapSummary lap;
+    uint64_t outputs = 0;
+    std::unique_ptr<TierDecimator> tiers;
+    for(auto _ : state) {
+        state.PauseTiming();
+        tiers = std::make_unique<TierDecimator>(generator.driverCount(), track.sectors);
+        state.ResumeTiming();
+
+        for(const auto& frame : recorded) {
+            outputs += tiers->process(frame, sector, lap);
+        }
+    }
+    benchmark::DoNotOptimize(outputs);
+
+    const double raw_bytes = static_cast<double>(tiers->emitted(StreamTier::FULL) * sizeof(TelemetryFrame));
+    state.counters["hz10_share"] = static_cast<double>(tiers->emitted(StreamTier::HZ10) * sizeof(TelemetryFrame)) / raw_bytes;
+    state.counters["sector_share"] = static_cast<double>(tiers->emitted(StreamTier::SECTOR) * sizeof(SectorEvent)) / raw_bytes;
+    state.counters["lap_share"] = static_cast<double>(tiers->emitted(StreamTier::LAP) * sizeof(LapSummary)) / raw_bytes;
+    state.SetItemsProcessed(state.iterations() * recorded.size());
+}
+BENCHMARK(BM_TierDecimator_Process)->Unit(benchmark::kMillisecond);
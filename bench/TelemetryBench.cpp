@@ -0,0 +1,90 @@
+#include "BenchUtil.h"
+#include "../src/telemetry/TelemetryGenerator.h"
+#include "../src/common/ForkJoinPool.h"
+#include "../src/common/SectorKernel.h"
+#include <benchmark/benchmark.h>
+
+// One simulation tick for the whole grid. Fails if a steady-state tick touches the heap.
+static void BM_TelemetryGenerator_Next(benchmark::State& state) {
+    const size_t grid_size = static_cast<size_t>(state.range(0));
+    const auto grid = BenchUtil::makeGrid(grid_size);
+
+    auto penalty_enforcer = std::make_shared<PenaltyEnforcer>(grid_size);
+    // Effectively endless race so the benchmark never runs past the finish.
+    TelemetryGenerator generator(BenchUtil::defaultTrack(), SeasonData::builtin(), grid, 1'000'000, penalty_enforcer);
+    std::vector<TelemetryFrame> frames(generator.driverCount());
+
+    generator.next(frames); // warm-up tick
+
+    const uint64_t allocations_before = BenchUtil::threadAllocations();
+    for(auto _ : state) {
+        generator.next(frames);
+        benchmark::DoNotOptimize(frames.data());
+        benchmark::ClobberMemory();
+    }
+    const uint64_t allocations = BenchUtil::threadAllocations() - allocations_before;
+
+    state.SetItemsProcessed(state.iterations() * grid_size);
+    state.counters["allocs_per_tick"] = benchmark::Counter(
+        static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+    if(allocations != 0) {
+        state.SkipWithError("steady-state tick allocated on the heap");
+    }
+}
+BENCHMARK(BM_TelemetryGenerator_Next)->Arg(20)->Arg(100)->Arg(1000);
+
+// Multi-class grid scaling: one tick for {cars, threads}. Threads counts the
+// calling thread, so 1 is the serial path. Real time is the tick latency.
+static void BM_TelemetryGenerator_Scaling(benchmark::State& state) {
+    const size_t grid_size = static_cast<size_t>(state.range(0));
+    const size_t threads = static_cast<size_t>(state.range(1));
+    const auto grid = BenchUtil::makeGrid(grid_size, 3);
+
+    auto penalty_enforcer = std::make_shared<PenaltyEnforcer>(grid_size);
+    auto pool = std::make_shared<ForkJoinPool>(threads - 1);
+    TelemetryGenerator generator(BenchUtil::defaultTrack(), SeasonData::builtin(), grid, 1'000'000, penalty_enforcer, pool);
+    std::vector<TelemetryFrame> frames(generator.driverCount());
+
+    generator.next(frames); // warm-up tick
+
+    for(auto _ : state) {
+        generator.next(frames);
+        benchmark::DoNotOptimize(frames.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * grid_size);
+}
+BENCHMARK(BM_TelemetryGenerator_Scaling)
+    ->ArgsProduct({{20, 100, 1000, 10000}, {1, 2, 4, 8}})
+    ->UseRealTime();
+
+// Sector progression for a 1000-car batch: the fixed 3-sector kernel against the
+// generic runtime-count loop it replaces on 3-sector tracks.
+template<uint8_t SECTORS>
+static void BM_SectorKernel_Advance(benchmark::State& state) {
+    constexpr size_t cars = 1000;
+    const TrackProfile& track = BenchUtil::defaultTrack();
+    const float sector_length = track.lap_length_km / track.sectors;
+
+    std::vector<float> distance(cars, 0.0f);
+    std::vector<uint8_t> sector(cars, 1);
+    std::vector<uint32_t> lap(cars, 0);
+    std::vector<float> delta(cars);
+    for(size_t i = 0; i < cars; i++) {
+        delta[i] = 0.10f + 0.05f * static_cast<float>(i % 7) / 7.0f;
+    }
+
+    for(auto _ : state) {
+        for(size_t i = 0; i < cars; i++) {
+            distance[i] += delta[i];
+            SectorKernel::advance<SECTORS>(distance[i], sector[i], lap[i], sector_length, track.sectors);
+        }
+        benchmark::DoNotOptimize(distance.data());
+        benchmark::DoNotOptimize(sector.data());
+        benchmark::DoNotOptimize(lap.data());
+    }
+    state.SetItemsProcessed(state.iterations() * cars);
+}
+BENCHMARK_TEMPLATE(BM_SectorKernel_Advance, 3);
+BENCHMARK_TEMPLATE(BM_SectorKernel_Advance, SectorKernel::DYNAMIC);
@@ -0,0 +1,185 @@
+#include "BenchUtil.h"
+#include "../src/transport/ShmPublisher.h"
+#include "../src/transport/ShmReader.h"
+#include "../src/ingestion/AsyncRingBuffer.h"
+#include "../src/monitoring/CycleClock.h"
+#include "../src/monitoring/LatencyHistogram.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr size_t TICK_FRAMES = 20;
+
+std::string benchRingName() {
+    return "/f1-bench-" + std::to_string(getpid());
+}
+
+struct LatencyReport {
+    uint64_t frames;
+    uint64_t lost;
+    uint64_t p50_ticks;
+    uint64_t p99_ticks;
+};
+
+void setLatencyCounters(benchmark::State& state, const LatencyReport& report) {
+    const double ticks_per_ns = CycleClock::ticksPerNs();
+    state.counters["p50_ns"] = static_cast<double>(report.p50_ticks) / ticks_per_ns;
+    state.counters["p99_ns"] = static_cast<double>(report.p99_ticks) / ticks_per_ns;
+    state.counters["lost"] = static_cast<double>(report.lost);
+}
+
+} // namespace
+
+// Writer cost of one 20-frame tick with no readers attached.
+static void BM_ShmRing_Publish(benchmark::State& state) {
+    ShmPublisher publisher;
+    if(!publisher.open(benchRingName(), 64 * 1024, TICK_FRAMES)) {
+        state.SkipWithError(publisher.error().c_str());
+        return;
+    }
+    std::vector<TelemetryFrame> frames(TICK_FRAMES);
+
+    for(auto _ : state) {
+        publisher.publish(frames);
+    }
+    state.SetItemsProcessed(state.iterations() * TICK_FRAMES);
+}
+BENCHMARK(BM_ShmRing_Publish);
+
+// Publishing one tick and reading it back in place (peek + advance, no copy) on the
+// same thread; the read cost is the difference from BM_ShmRing_Publish.
+static void BM_ShmRing_PublishReadInPlace(benchmark::State& state) {
+    ShmPublisher publisher;
+    ShmReader reader;
+    if(!publisher.open(benchRingName(), 64 * 1024, TICK_FRAMES) || !reader.attach(benchRingName())) {
+        state.SkipWithError("cannot create the shared-memory ring");
+        return;
+    }
+    std::vector<TelemetryFrame> frames(TICK_FRAMES);
+    float sum = 0.0f;
+
+    for(auto _ : state) {
+        publisher.publish(frames);
+        while(const TelemetryFrame* frame = reader.peek()) {
+            sum += frame->speed_kph;
+            reader.advance();
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * TICK_FRAMES);
+}
+BENCHMARK(BM_ShmRing_PublishReadInPlace);
+
+// One tick published to a reader in a forked process, which stamps the one-way
+// latency of every frame. Each tick waits until the reader has caught up, so the
+// reported latency is per hop, not queueing. Compare with BM_AsyncRingBuffer_Hop.
+static void BM_ShmRing_CrossProcess(benchmark::State& state) {
+    const std::string name = benchRingName();
+    ShmPublisher publisher;
+    int report_pipe[2];
+    if(!publisher.open(name, 64 * 1024, TICK_FRAMES) || pipe(report_pipe) != 0) {
+        state.SkipWithError("cannot create the shared-memory ring");
+        return;
+    }
+
+    const pid_t child = fork();
+    if(child == 0) {
+        ::close(report_pipe[0]);
+        ShmReader reader;
+        if(!reader.attach(name, true)) _exit(1);
+
+        auto histogram = std::make_unique<LatencyHistogram>();
+        LatencyReport report{0, 0, 0, 0};
+        while(!reader.finished()) {
+            const TelemetryFrame* frame = reader.peek();
+            if(!frame) {
+                if(!reader.writerAlive()) break;
+                sched_yield();
+                continue;
+            }
+            const uint64_t stamp = frame->timestamp_ns;
+            if(reader.advance()) {
+                histogram->record(CycleClock::now() - stamp);
+                report.frames++;
+            }
+        }
+        const auto snapshot = histogram->snapshot();
+        report.lost = reader.lost();
+        report.p50_ticks = snapshot.percentile(0.50);
+        report.p99_ticks = snapshot.percentile(0.99);
+        const ssize_t written = write(report_pipe[1], &report, sizeof(report));
+        _exit(written == sizeof(report) ? 0 : 1);
+    }
+    ::close(report_pipe[1]);
+
+    while(publisher.readers().empty()) sched_yield();
+
+    std::vector<TelemetryFrame> frames(TICK_FRAMES);
+    for(auto _ : state) {
+        const uint64_t now = CycleClock::now();
+        for(auto& frame : frames) frame.timestamp_ns = now;
+        publisher.publish(frames);
+        while(publisher.readers().front().lag > 0) sched_yield();
+    }
+    publisher.close();
+
+    LatencyReport report{0, 0, 0, 0};
+    const bool reported = read(report_pipe[0], &report, sizeof(report)) == sizeof(report);
+    ::close(report_pipe[0]);
+    waitpid(child, nullptr, 0);
+    if(!reported) {
+        state.SkipWithError("reader process failed");
+        return;
+    }
+    setLatencyCounters(state, report);
+    state.SetItemsProcessed(state.iterations() * TICK_FRAMES);
+}
+BENCHMARK(BM_ShmRing_CrossProcess)->UseRealTime();
+
+namespace {
+
+constexpr size_t HOP_TICKS = 200;
+
+Task hopProducer(AsyncRingBuffer<TelemetryFrame>& out) {
+    TelemetryFrame frame{};
+    for(size_t t = 0; t < HOP_TICKS; t++) {
+        const uint64_t now = CycleClock::now();
+        for(size_t i = 0; i < TICK_FRAMES; i++) {
+            frame.timestamp_ns = now;
+            co_await out.push(frame);
+        }
+    }
+    out.close();
+}
+
+Task hopConsumer(AsyncRingBuffer<TelemetryFrame>& in, LatencyHistogram& histogram) {
+    TelemetryFrame frame;
+    while(co_await in.pop(frame)) {
+        histogram.record(CycleClock::now() - frame.timestamp_ns);
+    }
+}
+
+} // namespace
+
+// The in-process path: the same 20-frame ticks through one AsyncRingBuffer hop
+// between two executor threads. The ring holds one tick, so the writer is at most
+// one tick ahead, as in BM_ShmRing_CrossProcess.
+static void BM_AsyncRingBuffer_Hop(benchmark::State& state) {
+    auto histogram = std::make_unique<LatencyHistogram>();
+    for(auto _ : state) {
+        Executor executor(2);
+        AsyncRingBuffer<TelemetryFrame> ring(TICK_FRAMES, executor);
+        executor.spawn(hopProducer(ring));
+        executor.spawn(hopConsumer(ring, *histogram));
+        executor.run();
+    }
+    const auto snapshot = histogram->snapshot();
+    setLatencyCounters(state, {snapshot.total, 0, snapshot.percentile(0.50), snapshot.percentile(0.99)});
+    state.SetItemsProcessed(state.iterations() * HOP_TICKS * TICK_FRAMES);
+}
+BENCHMARK(BM_AsyncRingBuffer_Hop)->UseRealTime();
@@ -0,0 +1,57 @@
+#include "BenchUtil.h"
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+    thread_local uint64_t thread_allocations = 0;
+}
+
+// Counting allocator so benchmarks can assert allocation-free hot paths.
+void* operator new(size_t size) {
+    thread_allocations++;
+    if(void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    thread_allocations++;
+    if(void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+uint64_t BenchUtil::threadAllocations() {
+    return thread_allocations;
+}
+
+int main(int argc, char** argv) {
+    // Emit JSON next to the console report unless the caller chose an output.
+    std::vector<char*> args(argv, argv + argc);
+    bool has_out = false;
+    for(int i = 1; i < argc; i++) {
+        if(std::strncmp(argv[i], "--benchmark_out=", 16) == 0) has_out = true;
+    }
+    std::string out_arg = "--benchmark_out=bench_results.json";
+    std::string format_arg = "--benchmark_out_format=json";
+    if(!has_out) {
+        args.push_back(out_arg.data());
+        args.push_back(format_arg.data());
+    }
+    int args_count = static_cast<int>(args.size());
+
+    BenchUtil::pinCurrentThread(0);
+
+    benchmark::Initialize(&args_count, args.data());
+    if(benchmark::ReportUnrecognizedArguments(args_count, args.data())) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,217 @@
+#include "RaceAnalytics.h"
+#include <algorithm>
+#include <iomanip>
+
+using namespace std;
+
+RaceAnalytics::RaceAnalytics(size_t driver_count, uint8_t sectors)
+    : sectors_(max<uint8_t>(sectors, 1)),
+      trackers_(driver_count, DriverTracker{}),
+      best_sector_s_(driver_count * sectors_, 0.0f),
+      last_sector_s_(driver_count * sectors_, 0.0f),
+      stints_(driver_count) {
+    for(auto& stints : stints_) {
+        stints.reserve(8);
+    }
+}
+
+void RaceAnalytics::processFrame(const TelemetryFrame& frame) {
+    lock_guard<mutex> lock(mutex_);
+
+    if(frame.driver_id >= trackers_.size()) return;
+    auto& t = trackers_[frame.driver_id];
+    const uint64_t now = frame.timestamp_ns;
+    const bool pitting = (frame.speed_kph == 0.0f);
+
+    if(!t.seen) {
+        // Frames are stamped at the end of a tick, so a stream that starts on lap 0,
+        // sector 1 is timed from the race start.
+        const bool at_start = (frame.lap == 0 && frame.sector == 1);
+        t.seen = true;
+        t.lap = frame.lap;
+        t.sector = frame.sector;
+        t.lap_timed = at_start;
+        t.sector_timed = at_start;
+        t.lap_start_ns = at_start ? 0 : now;
+        t.sector_start_ns = t.lap_start_ns;
+        t.in_pit = pitting;
+        t.stint_start_lap = frame.lap;
+        t.stint_start_wear = frame.tire_wear;
+        t.last_wear = frame.tire_wear;
+        sampleWear(t, frame.lap, frame.sector, frame.tire_wear);
+        return;
+    }
+
+    if(pitting && !t.in_pit) {
+        // Pit entry closes the stint on the tires the car came in on.
+        stints_[frame.driver_id].push_back(currentStint(t));
+        t.pit_stops++;
+        t.pit_this_lap = true;
+    } else if(!pitting && t.in_pit) {
+        t.stint_start_lap = frame.lap;
+        t.stint_start_wear = frame.tire_wear;
+        t.fit = WearFit{};
+        sampleWear(t, frame.lap, frame.sector, frame.tire_wear);
+    }
+    t.in_pit = pitting;
+    t.last_wear = frame.tire_wear;
+
+    if(frame.sector == t.sector && frame.lap == t.lap) return;
+
+    // Only time splits across a single observed boundary; dropped frames that
+    // skip a whole sector leave the affected split untimed.
+    const bool wraps = (t.sector >= sectors_);
+    const uint8_t next_sector = wraps ? 1 : t.sector + 1;
+    const uint32_t next_lap = wraps ? t.lap + 1 : t.lap;
+    const bool contiguous = (frame.sector == next_sector && frame.lap == next_lap);
+
+    if(contiguous && t.sector_timed) {
+        completeSector(t, frame.driver_id, now);
+    }
+    if(frame.lap != t.lap) {
+        if(contiguous && t.lap_timed) {
+            completeLap(t, now);
+        }
+        t.pit_this_lap = false;
+        t.lap_start_ns = now;
+        t.lap_timed = contiguous;
+    }
+    t.sector_start_ns = now;
+    t.sector_timed = contiguous;
+
+    t.lap = frame.lap;
+    t.sector = frame.sector;
+    if(!pitting) {
+        sampleWear(t, frame.lap, frame.sector, frame.tire_wear);
+    }
+}
+
+void RaceAnalytics::completeSector(DriverTracker& t, uint32_t driver_id, uint64_t now_ns) {
+    const float split = static_cast<float>((now_ns - t.sector_start_ns) * 1e-9);
+    const size_t index = static_cast<size_t>(driver_id) * sectors_ + (t.sector - 1);
+    last_sector_s_[index] = split;
+    if(best_sector_s_[index] == 0.0f || split < best_sector_s_[index]) {
+        best_sector_s_[index] = split;
+    }
+}
+
+void RaceAnalytics::completeLap(DriverTracker& t, uint64_t now_ns) {
+    const float lap_s = static_cast<float>((now_ns - t.lap_start_ns) * 1e-9);
+    t.laps_completed++;
+    t.last_lap_s = lap_s;
+    if(t.best_lap_s == 0.0f || lap_s < t.best_lap_s) {
+        t.best_lap_s = lap_s;
+    }
+    t.lap_sum_s += lap_s;
+
+    if(t.pit_this_lap) {
+        // Pit loss is measured against the clean laps run so far.
+        const float reference = t.clean_laps > 0 ? static_cast<float>(t.clean_lap_sum_s / t.clean_laps) : lap_s;
+        t.last_pit_loss_s = lap_s - reference;
+        t.total_pit_loss_s += t.last_pit_loss_s;
+    } else {
+        t.clean_laps++;
+        t.clean_lap_sum_s += lap_s;
+    }
+}
+
+void RaceAnalytics::sampleWear(DriverTracker& t, uint32_t lap, uint8_t sector, float wear) {
+    const double x = lap + static_cast<double>(sector - 1) / sectors_;
+    t.fit.n++;
+    t.fit.sum_x += x;
+    t.fit.sum_y += wear;
+    t.fit.sum_xy += x * wear;
+    t.fit.sum_xx += x * x;
+}
+
+float RaceAnalytics::slope(const WearFit& fit) {
+    if(fit.n < 2) return 0.0f;
+    const double denom = fit.n * fit.sum_xx - fit.sum_x * fit.sum_x;
+    if(denom <= 1e-12) return 0.0f;
+    return static_cast<float>((fit.n * fit.sum_xy - fit.sum_x * fit.sum_y) / denom);
+}
+
+StintSummary RaceAnalytics::currentStint(const DriverTracker& t) const {
+    return {t.stint_start_lap, t.lap, t.stint_start_wear, t.last_wear, slope(t.fit)};
+}
+
+DriverAnalytics RaceAnalytics::build(uint32_t driver_id) const {
+    const auto& t = trackers_[driver_id];
+    const size_t first = static_cast<size_t>(driver_id) * sectors_;
+
+    DriverAnalytics a;
+    a.driver_id = driver_id;
+    a.laps_completed = t.laps_completed;
+    a.best_lap_s = t.best_lap_s;
+    a.last_lap_s = t.last_lap_s;
+    a.mean_lap_s = t.laps_completed > 0 ? static_cast<float>(t.lap_sum_s / t.laps_completed) : 0.0f;
+    a.best_sector_s.assign(best_sector_s_.begin() + first, best_sector_s_.begin() + first + sectors_);
+    a.last_sector_s.assign(last_sector_s_.begin() + first, last_sector_s_.begin() + first + sectors_);
+    a.pit_stops = t.pit_stops;
+    a.total_pit_loss_s = t.total_pit_loss_s;
+    a.last_pit_loss_s = t.last_pit_loss_s;
+    a.stints = stints_[driver_id];
+    if(t.seen && !t.in_pit) {
+        a.stints.push_back(currentStint(t));
+    }
+    return a;
+}
+
+LapTimes RaceAnalytics::lapTimes(uint32_t driver_id) const {
+    lock_guard<mutex> lock(mutex_);
+    if(driver_id >= trackers_.size()) return LapTimes{0, 0.0f, 0.0f, 0.0f};
+    const auto& t = trackers_[driver_id];
+    const float mean = t.laps_completed > 0 ? static_cast<float>(t.lap_sum_s / t.laps_completed) : 0.0f;
+    return LapTimes{t.laps_completed, t.best_lap_s, t.last_lap_s, mean};
+}
+
+DriverAnalytics RaceAnalytics::driverAnalytics(uint32_t driver_id) const {
+    lock_guard<mutex> lock(mutex_);
+    if(driver_id >= trackers_.size()) {
+        return DriverAnalytics{driver_id, 0, 0.0f, 0.0f, 0.0f, {}, {}, 0, 0.0f, 0.0f, {}};
+    }
+    return build(driver_id);
+}
+
+vector<DriverAnalytics> RaceAnalytics::snapshot() const {
+    lock_guard<mutex> lock(mutex_);
+    vector<DriverAnalytics> all;
+    all.reserve(trackers_.size());
+    for(uint32_t i = 0; i < trackers_.size(); i++) {
+        all.push_back(build(i));
+    }
+    return all;
+}
+
+void RaceAnalytics::dump(ostream& out, const ProfileTable& profiles, const vector<GridEntry>& grid) const {
+    const vector<DriverAnalytics> all = snapshot();
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+
+    out << fixed << setprecision(3);
+    out << left << setw(20) << "driver" << right
+        << setw(6) << "laps" << setw(9) << "best" << setw(9) << "last" << setw(9) << "mean"
+        << setw(6) << "pits" << setw(10) << "pit loss" << "  best sectors / stints (wear per lap)\n";
+
+    for(const auto& a : all) {
+        if(a.driver_id < grid.size()) {
+            out << left << setw(20) << profiles.driverName(grid[a.driver_id].driver_index) << right;
+        } else {
+            out << "#" << left << setw(19) << a.driver_id << right;
+        }
+        out
+            << setw(6) << a.laps_completed
+            << setw(9) << a.best_lap_s << setw(9) << a.last_lap_s << setw(9) << a.mean_lap_s
+            << setw(6) << a.pit_stops << setw(10) << a.total_pit_loss_s << "  ";
+        for(size_t s = 0; s < a.best_sector_s.size(); s++) {
+            out << (s ? "/" : "") << a.best_sector_s[s];
+        }
+        for(const auto& stint : a.stints) {
+            out << "  [L" << stint.start_lap << "-" << stint.end_lap << " " << setprecision(4) << stint.wear_per_lap << setprecision(3) << "]";
+        }
+        out << "\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
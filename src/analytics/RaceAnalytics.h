@@ -0,0 +1,122 @@
+#pragma once
+
+#include "../common/types.h"
+#include "../data/ProfileTable.h"
+#include <vector>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+
+// One tire stint: from the start of the race or a pit exit until the next pit entry.
+struct StintSummary {
+    uint32_t start_lap;
+    uint32_t end_lap;          // lap of the pit entry, or the current lap while running
+    float start_wear;
+    float end_wear;
+    float wear_per_lap;        // least-squares slope of tire wear over laps
+};
+
+// Lap-time subset of DriverAnalytics; cheap enough to query on every redraw.
+struct LapTimes {
+    uint32_t laps_completed;
+    float best_lap_s;
+    float last_lap_s;
+    float mean_lap_s;
+};
+
+struct DriverAnalytics {
+    uint32_t driver_id;
+    uint32_t laps_completed;   // timed laps only
+
+    // Lap times in simulation seconds; 0 until the first timed lap.
+    float best_lap_s;
+    float last_lap_s;
+    float mean_lap_s;
+
+    std::vector<float> best_sector_s;
+    std::vector<float> last_sector_s;
+
+    uint32_t pit_stops;
+    float total_pit_loss_s;    // pit laps measured against the clean-lap mean
+    float last_pit_loss_s;
+
+    std::vector<StintSummary> stints; // completed stints, then the current one
+};
+
+// Incremental per-driver race analytics. Every frame updates fixed-size running
+// aggregates (O(1), no raw frames kept); only completed stints are appended, once
+// per pit stop. Lap and sector boundaries are detected from frame transitions,
+// so a driver's first partial lap is untimed unless their stream starts at the
+// race start.
+//
+// processFrame() is meant for one consumer thread; queries may come from others.
+class RaceAnalytics {
+public:
+    RaceAnalytics(size_t driver_count, uint8_t sectors);
+
+    void processFrame(const TelemetryFrame& frame);
+
+    LapTimes lapTimes(uint32_t driver_id) const;
+    DriverAnalytics driverAnalytics(uint32_t driver_id) const;
+    std::vector<DriverAnalytics> snapshot() const;
+
+    // Human-readable race summary; driver ids are slots in `grid`, which supplies
+    // names where available.
+    void dump(std::ostream& out, const ProfileTable& profiles, const std::vector<GridEntry>& grid) const;
+
+private:
+    // Running least-squares fit of wear against lap progress, sampled at sector boundaries.
+    struct WearFit {
+        uint32_t n;
+        double sum_x;
+        double sum_y;
+        double sum_xy;
+        double sum_xx;
+    };
+
+    struct DriverTracker {
+        bool seen;
+        bool lap_timed;        // current lap started on a boundary we observed
+        bool sector_timed;
+        bool in_pit;
+        bool pit_this_lap;
+
+        uint32_t lap;
+        uint8_t sector;
+        uint64_t lap_start_ns;
+        uint64_t sector_start_ns;
+
+        uint32_t laps_completed;
+        float best_lap_s;
+        float last_lap_s;
+        double lap_sum_s;
+
+        uint32_t clean_laps;
+        double clean_lap_sum_s;
+
+        uint32_t pit_stops;
+        float total_pit_loss_s;
+        float last_pit_loss_s;
+
+        uint32_t stint_start_lap;
+        float stint_start_wear;
+        float last_wear;
+        WearFit fit;
+    };
+
+    uint8_t sectors_;
+    std::vector<DriverTracker> trackers_;
+    std::vector<float> best_sector_s_;  // driver_count * sectors
+    std::vector<float> last_sector_s_;
+    std::vector<std::vector<StintSummary>> stints_;
+
+    mutable std::mutex mutex_;
+
+    void completeSector(DriverTracker& t, uint32_t driver_id, uint64_t now_ns);
+    void completeLap(DriverTracker& t, uint64_t now_ns);
+    void sampleWear(DriverTracker& t, uint32_t lap, uint8_t sector, float wear);
+    StintSummary currentStint(const DriverTracker& t) const;
+    DriverAnalytics build(uint32_t driver_id) const;
+
+    static float slope(const WearFit& fit);
+};
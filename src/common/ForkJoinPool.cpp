@@ -0,0 +1,71 @@
+#include "ForkJoinPool.h"
+
+using namespace std;
+
+ForkJoinPool::ForkJoinPool(size_t workers)
+    : generation_(0), stop_(false), task_fn_(nullptr), task_ctx_(nullptr),
+      task_count_(0), next_task_(0), active_workers_(0) {
+    workers_.reserve(workers);
+    for(size_t i = 0; i < workers; i++) {
+        workers_.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ForkJoinPool::~ForkJoinPool() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_start_.notify_all();
+    for(auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ForkJoinPool::dispatch(size_t count, TaskFn fn, void* ctx) {
+    {
+        lock_guard<mutex> lock(mutex_);
+        task_fn_ = fn;
+        task_ctx_ = ctx;
+        task_count_ = count;
+        next_task_.store(0, memory_order_relaxed);
+        active_workers_ = workers_.size();
+        generation_++;
+    }
+    cv_start_.notify_all();
+
+    // The caller works too, then waits for every worker to leave this generation so
+    // the task context (which lives on the caller's stack) is not used after return.
+    drain();
+
+    unique_lock<mutex> lock(mutex_);
+    cv_done_.wait(lock, [this]() { return active_workers_ == 0; });
+}
+
+void ForkJoinPool::drain() {
+    for(size_t i = next_task_.fetch_add(1, memory_order_relaxed); i < task_count_; i = next_task_.fetch_add(1, memory_order_relaxed)) {
+        task_fn_(task_ctx_, i);
+    }
+}
+
+void ForkJoinPool::workerLoop() {
+    uint64_t seen_generation = 0;
+
+    while(true) {
+        {
+            unique_lock<mutex> lock(mutex_);
+            cv_start_.wait(lock, [&]() { return stop_ || generation_ != seen_generation; });
+            if(stop_) return;
+            seen_generation = generation_;
+        }
+
+        drain();
+
+        bool last = false;
+        {
+            lock_guard<mutex> lock(mutex_);
+            last = (--active_workers_ == 0);
+        }
+        if(last) cv_done_.notify_one();
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads for fork-join parallel loops. run() hands out task
+// indices [0, count) to the workers and the calling thread, and returns once every
+// task has finished. Dispatch does not allocate, so it is safe to call every tick.
+//
+// run() must not be called concurrently from several threads on the same pool.
+class ForkJoinPool {
+public:
+    // `workers` extra threads; total parallelism is workers + 1 (the caller).
+    explicit ForkJoinPool(size_t workers);
+    ~ForkJoinPool();
+
+    ForkJoinPool(const ForkJoinPool&) = delete;
+    ForkJoinPool& operator=(const ForkJoinPool&) = delete;
+
+    size_t parallelism() const { return workers_.size() + 1; }
+
+    template<typename F>
+    void run(size_t count, F&& fn) {
+        if(count == 0) return;
+        if(workers_.empty() || count == 1) {
+            for(size_t i = 0; i < count; i++) fn(i);
+            return;
+        }
+        using Fn = std::remove_reference_t<F>;
+        dispatch(count, [](void* ctx, size_t i) { (*static_cast<Fn*>(ctx))(i); }, &fn);
+    }
+
+private:
+    using TaskFn = void (*)(void*, size_t);
+
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_start_;
+    std::condition_variable cv_done_;
+    uint64_t generation_;
+    bool stop_;
+
+    TaskFn task_fn_;
+    void* task_ctx_;
+    size_t task_count_;
+    std::atomic<size_t> next_task_;
+    size_t active_workers_;
+
+    void dispatch(size_t count, TaskFn fn, void* ctx);
+    void drain();
+    void workerLoop();
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+// Sector progression shared by the per-tick kernels of TelemetryGenerator and
+// RaceSimulator. Kernels are templated on the sector count and picked once at
+// construction; DYNAMIC is the generic fallback that reads the count at runtime.
+namespace SectorKernel {
+    constexpr uint8_t DYNAMIC = 0;
+
+    // Furthest a car can travel in one 20 ms tick at the 120x sim speed (km),
+    // with headroom over the ~0.155 km a 231 kph car covers.
+    constexpr float MAX_TICK_DISTANCE_KM = 0.2f;
+
+    // Fixed-count kernels assume at most one sector crossing per tick.
+    inline bool canSpecialize(float sector_length_km) {
+        return sector_length_km > MAX_TICK_DISTANCE_KM;
+    }
+
+    // Carries `distance_in_sector` over sector boundaries, wrapping to the next lap.
+    template<uint8_t SECTORS>
+    inline void advance(float& distance_in_sector, uint8_t& sector, uint32_t& lap, float sector_length, uint8_t sectors) {
+        if constexpr (SECTORS == DYNAMIC) {
+            while (distance_in_sector >= sector_length) {
+                distance_in_sector -= sector_length;
+                sector++;
+
+                if (sector > sectors) {
+                    sector = 1;
+                    lap++;
+                }
+            }
+        } else {
+            (void)sectors;
+            if (distance_in_sector >= sector_length) {
+                distance_in_sector -= sector_length;
+                if (sector == SECTORS) {
+                    sector = 1;
+                    lap++;
+                } else {
+                    sector++;
+                }
+            }
+        }
+    }
+}
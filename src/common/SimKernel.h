@@ -0,0 +1,160 @@
+#pragma once
+
+#include "types.h"
+#include "SectorKernel.h"
+#include <cstdint>
+
+// Per-car tick physics shared by TelemetryGenerator (the live race) and
+// RaceSimulator (strategy search), so pace, tire wear and sector progression
+// cannot drift apart between the two. What differs between them is chosen at
+// compile time:
+//
+//   Pit        how a stop is served: TimedPit holds the car in the pit lane for
+//              the stop's duration, InstantPit books the stop's time on the car's
+//              clock and skips one tick. Whether a car stops at all is decided by
+//              shouldPit(), the same rule for every caller.
+//   Penalties  time added to a stop and when the car may leave: NoPenalties, or a
+//              policy backed by the race-control PenaltyEnforcer.
+//   Frames     what is emitted per tick: NoFrames, or a policy that shapes the
+//              telemetry frame from the tick's state.
+//   Traffic    how the car ahead limits pace: NoTraffic, or a policy that holds a
+//              faster car up behind a slower one.
+//
+// With InstantPit, NoPenalties, NoFrames and NoTraffic the tick is just the physics.
+namespace SimKernel {
+    constexpr float TICK_SECONDS = 0.02f;
+    constexpr uint64_t TICK_NS = 20'000'000ULL;
+    // The simulation runs ~120x faster than real time for a reasonable race duration.
+    constexpr float SIM_SPEED_MULTIPLIER = 120.0f;
+    // Planned pit lap of a car that pits on tire wear instead.
+    constexpr uint32_t NO_PLAN = UINT32_MAX;
+
+    // Track geometry the tick needs; computed once so ticks never divide by it.
+    struct TrackConstants {
+        float sector_length_km;
+        float inv_lap_length_km;
+        float tire_wear_factor;
+        uint8_t sectors;
+
+        static TrackConstants of(const TrackProfile& track) {
+            return {track.lap_length_km / track.sectors, 1.0f / track.lap_length_km, track.tire_wear_factor, track.sectors};
+        }
+    };
+
+    // Tire wear above which a driver without a planned stop pits.
+    inline float pitThreshold(const DriverProfile& driver) {
+        const float base_threshold = 0.65f + (driver.tire_management * 0.25f);
+        const float risk_adjustment = (driver.risk_tolerance - 0.5f) * 0.15f;
+        return base_threshold + risk_adjustment;
+    }
+
+    // Stationary time of a stop, before penalties.
+    inline float pitStopSeconds(const CarProfile& car) {
+        return 2.0f + (1.0f - car.reliability) * 1.0f;
+    }
+
+    // Lap-average pace from driver skill, car performance and tire wear.
+    inline float paceKph(const DriverProfile& driver, const CarProfile& car, float tire_wear) {
+        const float driver_skill = 0.80f + driver.consistency * 0.25f;
+        return 220.0f * car.engine_power * driver_skill * (1.0f - tire_wear * 0.4f);
+    }
+
+    struct NoPenalties {
+        static constexpr bool ENABLED = false;
+        uint64_t servedAtStop(uint32_t, uint64_t) { return 0; }
+        bool complete(uint32_t, uint64_t) { return true; }
+    };
+
+    struct NoTraffic {
+        float limit(uint32_t, float speed) { return speed; }
+    };
+
+    struct NoFrames {
+        template<typename State>
+        void emit(uint32_t, State&, float, bool, uint64_t) {}
+    };
+
+    // State needs is_on_pit, pit_stop_start_time_ns and pit_stop_end_time_ns.
+    struct TimedPit {
+        template<typename State>
+        static bool inPitLane(const State& state) { return state.is_on_pit; }
+
+        // True while the car is held in the pit lane this tick.
+        template<typename State, typename Penalties>
+        static bool serve(State& state, const CarProfile& car, uint32_t id, bool pit_now, uint64_t now_ns, Penalties& penalties) {
+            if(pit_now && !state.is_on_pit) {
+                state.is_on_pit = true;
+                state.pit_stop_start_time_ns = now_ns;
+                uint64_t pit_duration = static_cast<uint64_t>(pitStopSeconds(car) * 1e9);
+                if constexpr (Penalties::ENABLED) {
+                    pit_duration += penalties.servedAtStop(id, now_ns);
+                }
+                state.pit_stop_end_time_ns = now_ns + pit_duration;
+            }
+            if(state.is_on_pit && now_ns >= state.pit_stop_end_time_ns && penalties.complete(id, now_ns)) {
+                state.is_on_pit = false;
+                state.tire_wear = 0.0f;
+            }
+            return state.is_on_pit;
+        }
+    };
+
+    // State needs total_time_seconds.
+    struct InstantPit {
+        template<typename State>
+        static bool inPitLane(const State&) { return false; }
+
+        template<typename State, typename Penalties>
+        static bool serve(State& state, const CarProfile& car, uint32_t id, bool pit_now, uint64_t now_ns, Penalties& penalties) {
+            if(!pit_now) return false;
+            state.total_time_seconds += pitStopSeconds(car);
+            if constexpr (Penalties::ENABLED) {
+                state.total_time_seconds += static_cast<float>(penalties.servedAtStop(id, now_ns)) * 1e-9f;
+            }
+            state.tire_wear = 0.0f;
+            return true;
+        }
+    };
+
+    // Whether a car starts a stop this tick. A car with a planned lap stops once, on
+    // that lap; any other car stops whenever its tire wear passes pitThreshold(), as
+    // often as that happens. Never while it is already in the pit lane. Taking the
+    // planned stop sets has_pitted. State needs lap, tire_wear and has_pitted.
+    template<typename Pit, typename State>
+    inline bool shouldPit(State& state, const DriverProfile& driver, uint32_t planned_lap) {
+        if(Pit::inPitLane(state)) return false;
+        if(planned_lap != NO_PLAN) {
+            if(state.lap != planned_lap || state.has_pitted) return false;
+            state.has_pitted = true;
+            return true;
+        }
+        return state.tire_wear > pitThreshold(driver);
+    }
+
+    // Advances one car by one tick. The caller decides whether the car pits this
+    // tick (normally with shouldPit()); the result is whether it moved (false while it is held for a stop).
+    // State needs lap, sector, tire_wear and distance_in_lap plus the pit policy's fields.
+    template<typename Pit, uint8_t SECTORS, typename State, typename Penalties, typename Frames, typename Traffic>
+    inline bool tick(const TrackConstants& track, uint32_t id, const DriverProfile& driver, const CarProfile& car,
+                     State& state, bool pit_now, uint64_t now_ns, Penalties& penalties, Frames& frames, Traffic& traffic) {
+        const bool held = Pit::serve(state, car, id, pit_now, now_ns, penalties);
+
+        float speed = 0.0f;
+        if(!held) {
+            speed = traffic.limit(id, paceKph(driver, car, state.tire_wear));
+            const float delta_distance_km = speed * (TICK_SECONDS / 3600.0f) * SIM_SPEED_MULTIPLIER;
+
+            // Tire wear scales with distance traveled (not per tick), so pit timing stays stable if sim speed changes.
+            // Tuned so typical first stops fall roughly in the 15–25 lap range depending on driver traits and track.
+            const float wear_per_lap = 0.05f * driver.aggression * track.tire_wear_factor; // 0..~0.05 per lap
+            state.tire_wear += (delta_distance_km * track.inv_lap_length_km) * wear_per_lap;
+            if(state.tire_wear > 1.0f) state.tire_wear = 1.0f;
+
+            state.distance_in_lap += delta_distance_km;
+            SectorKernel::advance<SECTORS>(state.distance_in_lap, state.sector, state.lap, track.sector_length_km, track.sectors);
+        }
+
+        frames.emit(id, state, speed, held, now_ns);
+        return !held;
+    }
+}
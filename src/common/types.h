@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cstdint>
-#include <string>
+
+// Handle to a string interned in a ProfileTable's string pool.
+using StringId = uint32_t;
 
 struct CarProfile {
-    std::string car_id;
+    uint16_t team_id;          // index into ProfileTable::teams()
 
     // Performance characteristics (0.0 – 1.0)
     float engine_power;        // top speed
@@ -14,7 +16,8 @@ struct CarProfile {
 };
 
 struct DriverProfile {
-    std::string driver_id;
+    StringId name;
+    uint16_t team_id;
 
     // behavioral traits (linearized to [0, 1])
     float aggression; // tire wear
@@ -23,14 +26,24 @@ struct DriverProfile {
     float risk_tolerance; // willingness to pit under uncertainty
 };
 
+// One car on the grid. Drivers and cars are looked up by index, so a large
+// synthetic field can reuse a handful of profiles without copying them.
+struct GridEntry {
+    uint32_t driver_index;
+    uint32_t car_index;
+    uint8_t  car_class;        // 0 for single-class races
+};
+
 struct TelemetryFrame {
-    uint8_t race_position;
+    uint32_t race_position;    // overall, 1-based
+    uint32_t class_position;   // within car_class, 1-based
 
     uint64_t timestamp_ns;
 
     uint32_t driver_id;
     uint32_t lap;
     uint8_t  sector;
+    uint8_t  car_class;
 
     // Vehicle state
     float speed_kph;
@@ -40,6 +53,46 @@ struct TelemetryFrame {
     // Tires
     float tire_temp_c[4];      // FL, FR, RL, RR
     float tire_wear;           // 0.0 (new) – 1.0 (dead)
+
+#ifdef F1_INSTRUMENTATION
+    // Wall-clock stamps (CycleClock ticks) for pipeline latency instrumentation.
+    uint64_t generated_at_ticks;
+    uint64_t pushed_at_ticks;
+#endif
+};
+
+// A car crossing a sector line, from the SECTOR stream tier. Aggregates cover the
+// sector just completed; the instantaneous values are from the crossing frame.
+struct SectorEvent {
+    uint64_t timestamp_ns;
+    uint32_t driver_id;
+    uint32_t lap;              // lap and sector being entered
+    uint8_t  sector;
+    uint8_t  car_class;
+    uint32_t race_position;
+
+    float sector_time_s;       // 0 if the sector's start was not observed
+    float avg_speed_kph;
+    float max_speed_kph;
+
+    float speed_kph;
+    float tire_wear;
+};
+
+// One completed lap, from the LAP stream tier.
+struct LapSummary {
+    uint64_t timestamp_ns;     // when the car crossed the line
+    uint32_t driver_id;
+    uint32_t lap;              // the lap completed
+    uint8_t  car_class;
+    bool     pitted;           // stopped at some point during the lap
+    uint32_t race_position;    // at the line
+
+    float lap_time_s;          // 0 if the lap's start was not observed
+    float avg_speed_kph;
+    float max_speed_kph;
+    float start_wear;
+    float end_wear;
 };
 
 struct TrackProfile {
@@ -59,6 +112,7 @@ struct DriverState {
     uint8_t sector;
     float tire_wear;
     float distance_in_lap;
+    float tire_temp_c[4];      // FL, FR, RL, RR
 
     bool is_on_pit;
     bool has_pitted;  // Prevent re-triggering a planned/optimal pit stop
@@ -0,0 +1,186 @@
+#include "ProfileTable.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+
+// Splits a line into fields: whitespace separated, "double quotes" around fields
+// with spaces, '#' to the end of the line is a comment. False on an unclosed quote.
+bool tokenize(string_view line, vector<string_view>& fields) {
+    fields.clear();
+    size_t i = 0;
+    while(i < line.size()) {
+        const char c = line[i];
+        if(c == ' ' || c == '\t' || c == '\r') {
+            i++;
+        } else if(c == '#') {
+            break;
+        } else if(c == '"') {
+            const size_t end = line.find('"', i + 1);
+            if(end == string_view::npos) return false;
+            fields.push_back(line.substr(i + 1, end - i - 1));
+            i = end + 1;
+        } else {
+            size_t end = i;
+            while(end < line.size() && line[end] != ' ' && line[end] != '\t' && line[end] != '\r' && line[end] != '#') end++;
+            fields.push_back(line.substr(i, end - i));
+            i = end;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+bool number(string_view field, T& out) {
+    const char* end = field.data() + field.size();
+    const auto result = from_chars(field.data(), end, out);
+    return result.ec == errc() && result.ptr == end;
+}
+
+bool unit(string_view field, float& out) {
+    return number(field, out) && out >= 0.0f && out <= 1.0f;
+}
+
+} // namespace
+
+shared_ptr<const ProfileTable> ProfileTable::load(const string& path, string& error) {
+    ifstream in(path);
+    if(!in) {
+        error = "cannot open " + path;
+        return nullptr;
+    }
+    stringstream text;
+    text << in.rdbuf();
+    auto table = parse(text.str(), error);
+    if(!table) error = path + ":" + error;
+    return table;
+}
+
+shared_ptr<const ProfileTable> ProfileTable::parse(string_view text, string& error) {
+    static atomic<uint32_t> next_generation{1};
+
+    auto table = make_shared<ProfileTable>();
+    table->generation_ = next_generation.fetch_add(1, memory_order_relaxed);
+    vector<string_view> fields;
+
+    auto findTeam = [&table](string_view key) -> int {
+        for(size_t t = 0; t < table->teams_.size(); t++) {
+            if(table->str(table->teams_[t].key) == key) return static_cast<int>(t);
+        }
+        return -1;
+    };
+
+    size_t line_number = 0;
+    size_t start = 0;
+    while(start <= text.size()) {
+        size_t end = text.find('\n', start);
+        if(end == string_view::npos) end = text.size();
+        const string_view line = text.substr(start, end - start);
+        start = end + 1;
+        line_number++;
+
+        auto fail = [&](const string& message) {
+            error = to_string(line_number) + ": " + message;
+            return nullptr;
+        };
+
+        if(!tokenize(line, fields)) return fail("unclosed quote");
+        if(fields.empty()) continue;
+
+        const string_view kind = fields[0];
+        if(kind == "team") {
+            if(fields.size() != 4) return fail("expected: team <key> \"<name>\" <badge>");
+            if(findTeam(fields[1]) >= 0) return fail("team '" + string(fields[1]) + "' is defined twice");
+            table->teams_.push_back({table->intern(fields[1]), table->intern(fields[2]), table->intern(fields[3])});
+        } else if(kind == "driver") {
+            DriverProfile d{};
+            if(fields.size() != 7) return fail("expected: driver \"<name>\" <team> <aggression> <consistency> <tire_management> <risk_tolerance>");
+            const int team = findTeam(fields[2]);
+            if(team < 0) return fail("unknown team '" + string(fields[2]) + "'");
+            if(!unit(fields[3], d.aggression) || !unit(fields[4], d.consistency)
+                || !unit(fields[5], d.tire_management) || !unit(fields[6], d.risk_tolerance)) {
+                return fail("driver traits must be numbers from 0 to 1");
+            }
+            d.name = table->intern(fields[1]);
+            d.team_id = static_cast<uint16_t>(team);
+            table->drivers_.push_back(d);
+        } else if(kind == "car") {
+            CarProfile c{};
+            if(fields.size() != 6) return fail("expected: car <team> <engine_power> <aero_efficiency> <cooling_efficiency> <reliability>");
+            const int team = findTeam(fields[1]);
+            if(team < 0) return fail("unknown team '" + string(fields[1]) + "'");
+            if(!unit(fields[2], c.engine_power) || !unit(fields[3], c.aero_efficiency)
+                || !unit(fields[4], c.cooling_efficiency) || !unit(fields[5], c.reliability)) {
+                return fail("car characteristics must be numbers from 0 to 1");
+            }
+            c.team_id = static_cast<uint16_t>(team);
+            table->cars_.push_back(c);
+        } else if(kind == "track") {
+            TrackProfile t{};
+            uint32_t sectors = 0;
+            if(fields.size() != 7) return fail("expected: track <id> <sectors> <lap_length_km> <tire_wear_factor> <overtaking_difficulty> <safety_car_probability>");
+            if(!number(fields[1], t.track_id) || !number(fields[2], sectors) || !number(fields[3], t.lap_length_km)
+                || !number(fields[4], t.tire_wear_factor) || !unit(fields[5], t.overtaking_difficulty)
+                || !unit(fields[6], t.safety_car_probability)) {
+                return fail("invalid track field");
+            }
+            if(sectors < 1 || sectors > 255 || t.lap_length_km <= 0.0f || t.tire_wear_factor < 0.0f) {
+                return fail("track needs 1-255 sectors, a positive lap length and a non-negative wear factor");
+            }
+            if(table->findTrack(t.track_id)) return fail("track " + to_string(t.track_id) + " is defined twice");
+            t.sectors = static_cast<uint8_t>(sectors);
+            table->tracks_.push_back(t);
+        } else {
+            return fail("unknown record '" + string(kind) + "'");
+        }
+    }
+
+    if(table->drivers_.empty()) {
+        error = "no drivers defined";
+        return nullptr;
+    }
+    if(table->cars_.size() != table->drivers_.size()) {
+        error = to_string(table->drivers_.size()) + " drivers but " + to_string(table->cars_.size()) + " cars (driver i drives car i)";
+        return nullptr;
+    }
+    if(table->tracks_.empty()) {
+        error = "no tracks defined";
+        return nullptr;
+    }
+    return table;
+}
+
+string_view ProfileTable::str(StringId id) const {
+    return string_view(pool_.data() + id);
+}
+
+const TrackProfile* ProfileTable::findTrack(uint32_t track_id) const {
+    for(const auto& track : tracks_) {
+        if(track.track_id == track_id) return &track;
+    }
+    return nullptr;
+}
+
+vector<GridEntry> ProfileTable::defaultGrid() const {
+    vector<GridEntry> grid(min(drivers_.size(), cars_.size()));
+    for(uint32_t i = 0; i < grid.size(); i++) {
+        grid[i] = {i, i, 0};
+    }
+    return grid;
+}
+
+StringId ProfileTable::intern(string_view s) {
+    // The pool holds a few hundred bytes, so a scan is cheaper than a hash map.
+    for(size_t at = 0; at < pool_.size(); at += str(static_cast<StringId>(at)).size() + 1) {
+        if(str(static_cast<StringId>(at)) == s) return static_cast<StringId>(at);
+    }
+    const StringId id = static_cast<StringId>(pool_.size());
+    pool_.append(s);
+    pool_.push_back('\0');
+    return id;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../common/types.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+// Season definition (teams, drivers, cars and tracks) loaded at startup and then
+// immutable. Engines share one table through shared_ptr<const ProfileTable>
+// instead of copying profile vectors, and refer to drivers and teams by index:
+// names and badges live once in the table's string pool and are only looked up
+// for display.
+//
+// The text format is one record per line (see data/season-2025.txt):
+//
+//     team   <key> "<name>" <badge>
+//     driver "<name>" <team> <aggression> <consistency> <tire_management> <risk_tolerance>
+//     car    <team> <engine_power> <aero_efficiency> <cooling_efficiency> <reliability>
+//     track  <id> <sectors> <lap_length_km> <tire_wear_factor> <overtaking_difficulty> <safety_car_probability>
+//
+// Driver i drives car i, so there must be as many cars as drivers.
+class ProfileTable {
+public:
+    struct Team {
+        StringId key;
+        StringId name;
+        StringId badge;   // short display marker, e.g. a colored emoji
+    };
+
+    // nullptr with `error` set (including the line number) if the file cannot be
+    // read or is invalid.
+    static std::shared_ptr<const ProfileTable> load(const std::string& path, std::string& error);
+    static std::shared_ptr<const ProfileTable> parse(std::string_view text, std::string& error);
+
+    const std::vector<Team>& teams() const { return teams_; }
+    const std::vector<DriverProfile>& drivers() const { return drivers_; }
+    const std::vector<CarProfile>& cars() const { return cars_; }
+    const std::vector<TrackProfile>& tracks() const { return tracks_; }
+
+    std::string_view str(StringId id) const;
+    std::string_view driverName(uint32_t driver) const { return str(drivers_[driver].name); }
+    std::string_view teamName(uint16_t team) const { return str(teams_[team].name); }
+    std::string_view teamBadge(uint16_t team) const { return str(teams_[team].badge); }
+
+    // nullptr if there is no track with that id.
+    const TrackProfile* findTrack(uint32_t track_id) const;
+
+    // The season grid: entry i is driver i in car i, single class.
+    std::vector<GridEntry> defaultGrid() const;
+
+    // Unique per parsed table within the process, so caches keyed by driver or car
+    // index can tell seasons apart.
+    uint32_t generation() const { return generation_; }
+
+private:
+    // Interned strings, each NUL-terminated; a StringId is an offset into it.
+    std::string pool_;
+    std::vector<Team> teams_;
+    std::vector<DriverProfile> drivers_;
+    std::vector<CarProfile> cars_;
+    std::vector<TrackProfile> tracks_;
+    uint32_t generation_ = 0;
+
+    StringId intern(std::string_view s);
+};
@@ -0,0 +1,25 @@
+#include "season_data.h"
+#include "season_text.h"
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+const shared_ptr<const ProfileTable>& SeasonData::builtin() {
+    static const shared_ptr<const ProfileTable> table = []() {
+        string error;
+        auto parsed = ProfileTable::parse(SEASON_2025_TEXT, error);
+        if(!parsed) {
+            // Only reachable if data/season-2025.txt was broken at build time.
+            cerr << "Built-in season profiles are invalid: line " << error << "\n";
+            abort();
+        }
+        return parsed;
+    }();
+    return table;
+}
+
+shared_ptr<const ProfileTable> SeasonData::load(const string& path, string& error) {
+    if(path.empty()) return builtin();
+    return ProfileTable::load(path, error);
+}
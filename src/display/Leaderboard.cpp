@@ -0,0 +1,142 @@
+#include "Leaderboard.h"
+#include "../monitoring/Instrumentation.h"
+#include <algorithm>
+
+using namespace std;
+
+Leaderboard::Leaderboard(shared_ptr<const ProfileTable> profiles, const vector<GridEntry>& grid,
+                         const TrackProfile& track, uint32_t total_laps,
+                         const RaceAnalytics& analytics, const TrackLimitsMonitor& track_limits,
+                         shared_ptr<const PenaltyEnforcer> penalties, const PipelineStats* stats)
+    : profiles_(std::move(profiles)), grid_(grid), track_(track), total_laps_(total_laps), analytics_(analytics),
+      track_limits_(track_limits), penalties_(std::move(penalties)), stats_(stats),
+      latest_(grid_.size()), sorted_(grid_.size()), frame_count_(0) {
+    // Valid positions before the first frames, so the first redraw sorts sensibly.
+    for(size_t i = 0; i < latest_.size(); i++) {
+        latest_[i].driver_id = static_cast<uint32_t>(i);
+        latest_[i].race_position = static_cast<uint32_t>(i + 1);
+        latest_[i].lap = 0;
+        latest_[i].sector = 1;
+    }
+}
+
+bool Leaderboard::update(const TelemetryFrame& frame) {
+    latest_[frame.driver_id] = frame;
+    frame_count_++;
+    return frame_count_ % latest_.size() == 0;
+}
+
+void Leaderboard::render(ostream& out) {
+    out << "\033[2J\033[H";
+
+    uint32_t currentLap = 0;
+    for(const auto& f : latest_) {
+        if(f.lap > currentLap) currentLap = f.lap;
+    }
+
+    out << "\n🏁 LAP " << currentLap << "/" << total_laps_ << " 🏁\n";
+    out << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n";
+
+    copy(latest_.begin(), latest_.end(), sorted_.begin());
+    sort(sorted_.begin(), sorted_.end(),
+            [](const TelemetryFrame& a, const TelemetryFrame& b) {
+                return a.race_position < b.race_position;
+            });
+
+    const vector<CarProfile>& cars = profiles_->cars();
+    for(const auto& f : sorted_) {
+        const char* posColor = "\033[1;33m";
+        if(f.race_position == 1) posColor = "\033[1;93m";
+        else if(f.race_position == 2) posColor = "\033[1;37m";
+        else if(f.race_position == 3) posColor = "\033[1;91m";
+
+        out << posColor << "P" << int(f.race_position);
+        if(f.race_position < 10) out << " ";
+        out << "\033[0m ";
+
+        // Team badge by team id, straight from the profile table.
+        const GridEntry& entry = grid_[f.driver_id];
+        out << profiles_->teamBadge(cars[entry.car_index].team_id) << " ";
+
+        const string_view name = profiles_->driverName(entry.driver_index);
+        out << "\033[1m" << name << "\033[0m";
+        for(size_t i = name.length(); i < 20; i++) out << " ";
+
+        int barLength = 10;
+        float progress = (f.sector - 1) / float(track_.sectors);
+        int filled = int(progress * barLength);
+        out << " ";
+        for(int i = 0; i < barLength; i++) {
+            if(i < filled) out << "█";
+            else out << "░";
+        }
+
+        out << " Lap " << f.lap;
+
+        if(f.speed_kph == 0.0f) {
+            out << "  \033[1;35m[IN PITS]\033[0m";
+        } else {
+            const char* speedColor = "\033[32m";
+            if(f.speed_kph < 150) speedColor = "\033[31m";
+            else if(f.speed_kph < 200) speedColor = "\033[33m";
+
+            out << "  Speed: " << speedColor << int(f.speed_kph) << " kph\033[0m";
+        }
+
+        float tirePercent = f.tire_wear * 100;
+        const char* tireColor = "\033[32m";
+        if(tirePercent > 70) tireColor = "\033[31m";
+        else if(tirePercent > 40) tireColor = "\033[33m";
+
+        out << "  Tire: " << tireColor << int(tirePercent) << "%\033[0m";
+
+        const LapTimes lapInfo = analytics_.lapTimes(f.driver_id);
+        if(lapInfo.laps_completed > 0) {
+            out << "  \033[90mLast " << lapInfo.last_lap_s << "s  Best " << lapInfo.best_lap_s << "s\033[0m";
+        }
+
+        out << "\n";
+    }
+
+    out << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n";
+
+    out << "\n⚠️  TRACK LIMITS VIOLATIONS:\n";
+    bool any_violations = false;
+    for(const auto& f : sorted_) {
+        uint32_t warnings = track_limits_.getWarnings(f.driver_id);
+        DriverPenaltyInfo penalty = penalties_->getPenaltyInfo(f.driver_id);
+
+        if(warnings > 0) {
+            any_violations = true;
+            out << "   " << profiles_->driverName(grid_[f.driver_id].driver_index) << ": ";
+            out << warnings << " warning" << (warnings > 1 ? "s" : "");
+
+            // Add penalty status
+            if(penalty.state == PenaltyState::PENDING) {
+                out << " \033[1;33m[PENALTY PENDING]\033[0m";
+            } else if(penalty.state == PenaltyState::SERVING) {
+                out << " \033[1;31m[SERVING PENALTY]\033[0m";
+            } else if(penalty.state == PenaltyState::SERVED) {
+                out << " \033[1;32m[PENALTY SERVED]\033[0m";
+            }
+            out << "\n";
+        }
+    }
+
+    if(!any_violations) {
+        out << "   \033[90mNone\033[0m\n";
+    }
+
+    if constexpr (Instrumentation::ENABLED) {
+        if(stats_) {
+            PipelineStatsSnapshot stats = stats_->snapshot();
+            const auto& age = stats.stages[static_cast<size_t>(PipelineStage::END_TO_END)];
+            const auto& jitter = stats.stages[static_cast<size_t>(PipelineStage::TICK_JITTER)];
+            out << "\033[90mFrame age p50 " << int(age.p50_ns / 1000) << " us, p99 " << int(age.p99_ns / 1000)
+                << " us | tick jitter p50 " << int(jitter.p50_ns / 1000) << " us, p99 " << int(jitter.p99_ns / 1000)
+                << " us | ring high-water " << stats.ring_high_water << "\033[0m\n";
+        }
+    }
+    out << "\033[90mRace runs until finish\033[0m\n";
+    out.flush();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../common/types.h"
+#include "../data/ProfileTable.h"
+#include "../analytics/RaceAnalytics.h"
+#include "../race-control/TrackLimitsMonitor.h"
+#include "../race-control/PenaltyEnforcer.h"
+#include "../monitoring/PipelineStats.h"
+#include <vector>
+#include <memory>
+#include <ostream>
+#include <cstdint>
+
+// Terminal leaderboard for the live race: keeps each car's latest frame and
+// redraws once a whole tick's worth of frames has arrived. Frame driver ids are
+// slots in `grid`, which maps them to driver and car profiles. Buffers are sized
+// once, so steady-state updates and redraws do not allocate.
+class Leaderboard {
+public:
+    Leaderboard(std::shared_ptr<const ProfileTable> profiles, const std::vector<GridEntry>& grid,
+                const TrackProfile& track, uint32_t total_laps,
+                const RaceAnalytics& analytics, const TrackLimitsMonitor& track_limits,
+                std::shared_ptr<const PenaltyEnforcer> penalties, const PipelineStats* stats = nullptr);
+
+    // Records `frame`; true when the board is due for a redraw.
+    bool update(const TelemetryFrame& frame);
+    void render(std::ostream& out);
+
+private:
+    std::shared_ptr<const ProfileTable> profiles_;
+    std::vector<GridEntry> grid_;
+    TrackProfile track_;
+    uint32_t total_laps_;
+    const RaceAnalytics& analytics_;
+    const TrackLimitsMonitor& track_limits_;
+    std::shared_ptr<const PenaltyEnforcer> penalties_;
+    const PipelineStats* stats_;
+
+    std::vector<TelemetryFrame> latest_;
+    std::vector<TelemetryFrame> sorted_;   // reused on every redraw
+    size_t frame_count_;
+};
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "../runtime/Executor.h"
+#include <vector>
+#include <memory_resource>
+#include <cstddef>
+#include <mutex>
+#include <coroutine>
+
+// Bounded ring for coroutine stages. Where RingBuffer blocks a thread, reads and
+// writes here suspend the calling coroutine and the other side reschedules it on
+// the executor:
+//
+//     while(co_await in.pop(frame)) { ... co_await out.push(frame); }
+//
+// push() waits for space (backpressure) instead of failing when full. close() ends
+// the stream: pending and later pushes return false, pops drain what is left and
+// then return false.
+template<typename T>
+class AsyncRingBuffer {
+public:
+    // `memory` backs the slot array, e.g. a NumaMemoryResource for the stage's node.
+    AsyncRingBuffer(size_t capacity, Executor& executor, std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    class PushAwaiter {
+    public:
+        PushAwaiter(AsyncRingBuffer& ring, const T& item) : ring_(ring), item_(item) {}
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle) { return ring_.suspendPush(*this, handle); }
+        bool await_resume() const noexcept { return result_; }
+
+    private:
+        friend class AsyncRingBuffer;
+
+        AsyncRingBuffer& ring_;
+        const T& item_;
+        std::coroutine_handle<> handle_;
+        bool result_ = false;
+        PushAwaiter* next_ = nullptr;
+    };
+
+    class PopAwaiter {
+    public:
+        PopAwaiter(AsyncRingBuffer& ring, T& item) : ring_(ring), item_(item) {}
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle) { return ring_.suspendPop(*this, handle); }
+        bool await_resume() const noexcept { return result_; }
+
+    private:
+        friend class AsyncRingBuffer;
+
+        AsyncRingBuffer& ring_;
+        T& item_;
+        std::coroutine_handle<> handle_;
+        bool result_ = false;
+        PopAwaiter* next_ = nullptr;
+    };
+
+    // co_await push(item): true once stored, false if the ring is closed.
+    PushAwaiter push(const T& item) { return PushAwaiter(*this, item); }
+    // co_await pop(item): true with `item` filled, false once closed and drained.
+    PopAwaiter pop(T& item) { return PopAwaiter(*this, item); }
+
+    size_t size() const;
+
+    void close();
+
+private:
+    // Intrusive FIFO of suspended awaiters; the awaiters live in the waiting
+    // coroutines' frames, so queueing does not allocate.
+    template<typename Awaiter>
+    struct WaitQueue {
+        Awaiter* head = nullptr;
+        Awaiter* tail = nullptr;
+
+        void push(Awaiter* a) {
+            a->next_ = nullptr;
+            if(tail) tail->next_ = a;
+            else head = a;
+            tail = a;
+        }
+
+        Awaiter* pop() {
+            Awaiter* a = head;
+            if(a) {
+                head = a->next_;
+                if(!head) tail = nullptr;
+            }
+            return a;
+        }
+    };
+
+    std::pmr::vector<T> buffer_;
+    size_t capacity_;
+    Executor& executor_;
+    mutable std::mutex mutex_;
+
+    bool closed_;
+    size_t head_;
+    size_t tail_;
+    size_t count_;
+
+    // Writers only wait while the ring is full and readers only while it is empty.
+    WaitQueue<PushAwaiter> push_waiters_;
+    WaitQueue<PopAwaiter> pop_waiters_;
+
+    // Return true to stay suspended; the awaiter is then resumed through the executor.
+    bool suspendPush(PushAwaiter& a, std::coroutine_handle<> handle);
+    bool suspendPop(PopAwaiter& a, std::coroutine_handle<> handle);
+};
+
+template<typename T>
+AsyncRingBuffer<T>::AsyncRingBuffer(size_t capacity, Executor& executor, std::pmr::memory_resource* memory)
+    : buffer_(capacity, memory), capacity_(capacity), executor_(executor), closed_(false), head_(0), tail_(0), count_(0) {}
+
+template<typename T>
+bool AsyncRingBuffer<T>::suspendPush(PushAwaiter& a, std::coroutine_handle<> handle) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if(closed_) {
+        a.result_ = false;
+        return false;
+    }
+
+    // A waiting reader means the ring is empty: hand the item over directly.
+    if(PopAwaiter* reader = pop_waiters_.pop()) {
+        reader->item_ = a.item_;
+        reader->result_ = true;
+        lock.unlock();
+        executor_.schedule(reader->handle_);
+        a.result_ = true;
+        return false;
+    }
+
+    if(count_ < capacity_) {
+        buffer_[head_] = a.item_;
+        head_ = (head_ + 1) % capacity_;
+        count_++;
+        a.result_ = true;
+        return false;
+    }
+
+    a.handle_ = handle;
+    push_waiters_.push(&a);
+    return true;
+}
+
+template<typename T>
+bool AsyncRingBuffer<T>::suspendPop(PopAwaiter& a, std::coroutine_handle<> handle) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if(count_ > 0) {
+        a.item_ = buffer_[tail_];
+        tail_ = (tail_ + 1) % capacity_;
+        count_--;
+        a.result_ = true;
+
+        // The slot just freed goes to the longest-waiting writer.
+        if(PushAwaiter* writer = push_waiters_.pop()) {
+            buffer_[head_] = writer->item_;
+            head_ = (head_ + 1) % capacity_;
+            count_++;
+            writer->result_ = true;
+            lock.unlock();
+            executor_.schedule(writer->handle_);
+        }
+        return false;
+    }
+
+    if(closed_) {
+        a.result_ = false;
+        return false;
+    }
+
+    a.handle_ = handle;
+    pop_waiters_.push(&a);
+    return true;
+}
+
+template<typename T>
+size_t AsyncRingBuffer<T>::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_;
+}
+
+template<typename T>
+void AsyncRingBuffer<T>::close() {
+    WaitQueue<PushAwaiter> writers;
+    WaitQueue<PopAwaiter> readers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(closed_) return;
+        closed_ = true;
+        writers = push_waiters_;
+        readers = pop_waiters_;
+        push_waiters_ = {};
+        pop_waiters_ = {};
+    }
+
+    while(PushAwaiter* w = writers.pop()) {
+        w->result_ = false;
+        executor_.schedule(w->handle_);
+    }
+    while(PopAwaiter* r = readers.pop()) {
+        r->result_ = false;
+        executor_.schedule(r->handle_);
+    }
+}
@@ -12,13 +12,19 @@ public:
 
     bool push(const T& item);
     bool pop(T& item);
+    // Non-blocking pop: false at once if the ring is empty. For evicting the oldest
+    // item on overflow, where a blocking pop could wait forever if consumers drain
+    // the ring between the failed push and the pop.
+    bool tryPop(T& item);
+
+    size_t size() const;
 
     void shutdown();
 
 private:
     std::vector<T> buffer_;
     size_t capacity_;
-    std::mutex mutex_;
+    mutable std::mutex mutex_;
     std::condition_variable cv_not_full_;
     std::condition_variable cv_not_empty_;
 
@@ -73,6 +79,29 @@ bool RingBuffer<T>::pop(T& item) {
     return true;
 }
 
+template<typename T>
+bool RingBuffer<T>::tryPop(T& item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if(head_ == tail_) {
+        return false;
+    }
+
+    item = buffer_[tail_];
+    tail_ = (tail_ + 1) % capacity_;
+
+    lock.unlock();
+    cv_not_full_.notify_one();
+
+    return true;
+}
+
+template<typename T>
+size_t RingBuffer<T>::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return (head_ + capacity_ - tail_) % capacity_;
+}
+
 template<typename T>
 void RingBuffer<T>::shutdown() {
     std::lock_guard<std::mutex> lock(mutex_);
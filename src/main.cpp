@@ -1,16 +1,29 @@
-#include "ingestion/RingBuffer.h"
+#include "ingestion/AsyncRingBuffer.h"
+#include "runtime/Executor.h"
+#include "runtime/Topology.h"
+#include "runtime/NumaMemoryResource.h"
 #include "telemetry/TelemetryGenerator.h"
 #include "strategy/StrategyAnalyzer.h"
 #include "data/season_data.h"
 #include "race-control/TrackLimitsMonitor.h"
 #include "race-control/PenaltyEnforcer.h"
-#include <thread>
+#include "analytics/RaceAnalytics.h"
+#include "display/Leaderboard.h"
+#include "query/TelemetryTable.h"
+#include "transport/ShmPublisher.h"
+#include "streams/TierDecimator.h"
+#include "monitoring/Instrumentation.h"
+#include "monitoring/PipelineStats.h"
+#include "monitoring/MetricsRegistry.h"
+#include "monitoring/MetricsExporter.h"
 #include <chrono>
 #include <iostream>
 #include <vector>
-#include <atomic>
 #include <algorithm>
 #include <sstream>
+#include <memory>
+#include <cstdlib>
+#include <random>
 
 using namespace std;
 
@@ -32,26 +45,153 @@ vector<uint32_t> parseDriverIds(const string& input, size_t max_id){
     return driver_ids;
 }
 
+using FrameRing = AsyncRingBuffer<TelemetryFrame>;
+using SectorRing = AsyncRingBuffer<SectorEvent>;
+using LapRing = AsyncRingBuffer<LapSummary>;
+
+// Subscribers per stream tier; a null ring means nobody consumes that tier.
+struct TierSubscribers {
+    FrameRing* full = nullptr;
+    FrameRing* hz10 = nullptr;
+    SectorRing* sectors = nullptr;
+    LapRing* laps = nullptr;
+};
+
+// Source stage: one tick every 20 ms until the race is finished, then closes `out`.
+// Each tick is also published once to `shm` (if any) for out-of-process readers.
+Task generatorStage(Executor& executor, TelemetryGenerator& generator, FrameRing& out, ShmPublisher* shm, PipelineStats& stats, uint32_t& winner){
+    constexpr auto TICK_PERIOD = chrono::milliseconds(20);
+    const uint64_t period_ticks = Instrumentation::ENABLED
+        ? static_cast<uint64_t>(chrono::nanoseconds(TICK_PERIOD).count() * CycleClock::ticksPerNs())
+        : 0;
+    uint64_t last_tick_at = 0;
+
+    // Reused every tick; generator.next() fills it in place.
+    vector<TelemetryFrame> frames(generator.driverCount());
+
+    // Fixed-rate schedule, so a late tick does not push back every later one.
+    auto next_tick = Executor::Clock::now();
+    while(true) {
+        Instrumentation::onTick(stats, last_tick_at, period_ticks);
+        generator.next(frames);
+
+        if(generator.isRaceFinished()) {
+            if(shm) shm->close();
+            for(const auto& frame : frames) {
+                if(frame.race_position == 1) {
+                    winner = frame.driver_id;
+                    break;
+                }
+            }
+            break;
+        }
+
+        if(shm) shm->publish(frames);
+
+        const uint64_t pushed_at = Instrumentation::now();
+        for(auto& frame : frames) {
+            Instrumentation::onPush(stats, frame, pushed_at);
+            // Waits for space rather than dropping when downstream falls behind.
+            if(!co_await out.push(frame)) co_return;
+            Metrics::increment(Counter::FRAMES_PUSHED);
+        }
+        const size_t depth = out.size();
+        Metrics::set(Gauge::RING_DEPTH, static_cast<int64_t>(depth));
+        Instrumentation::onOccupancy(stats, depth);
+        next_tick += TICK_PERIOD;
+        co_await executor.sleepUntil(next_tick);
+    }
+    out.close();
+}
+
+// Runs `process` on every frame from `in` and forwards it to `out` (if any).
+// Closing `in` closes `out`, so shutdown ripples down the pipeline.
+template<typename Process>
+Task frameStage(FrameRing& in, FrameRing* out, Process process){
+    TelemetryFrame frame;
+    while(co_await in.pop(frame)) {
+        process(frame);
+        if(out && !co_await out->push(frame)) break;
+    }
+    if(out) out->close();
+}
+
+// Splits the raw stream into its tiers in one pass and gives each subscriber only
+// its tier. Closing `in` closes every subscriber. As the generator ring's only
+// reader, this is where frames are counted as popped; their age is taken when the
+// leaderboard renders them.
+Task tierStage(FrameRing& in, TierDecimator& tiers, TierSubscribers out, PipelineStats& stats){
+    TelemetryFrame frame;
+    SectorEvent sector;
+    LapSummary lap;
+    while(co_await in.pop(frame)) {
+        const uint64_t popped_at = Instrumentation::onPop(stats, frame);
+        Metrics::increment(Counter::FRAMES_POPPED);
+
+        const uint8_t produced = tiers.process(frame, sector, lap);
+        Instrumentation::onProcessed(stats, frame, popped_at);
+        bool open = true;
+        if(out.full) {
+            open = co_await out.full->push(frame);
+        }
+        if(open && out.hz10 && (produced & tierBit(StreamTier::HZ10))) {
+            open = co_await out.hz10->push(frame);
+        }
+        if(open && out.sectors && (produced & tierBit(StreamTier::SECTOR))) {
+            open = co_await out.sectors->push(sector);
+        }
+        if(open && out.laps && (produced & tierBit(StreamTier::LAP))) {
+            open = co_await out.laps->push(lap);
+        }
+        if(!open) break;
+    }
+    if(out.full) out.full->close();
+    if(out.hz10) out.hz10->close();
+    if(out.sectors) out.sectors->close();
+    if(out.laps) out.laps->close();
+}
+
+// Runs `process` on every sector event or lap summary from `in` until it closes.
+template<typename T, typename Process>
+Task eventStage(AsyncRingBuffer<T>& in, Process process){
+    T item;
+    while(co_await in.pop(item)) {
+        process(item);
+    }
+}
+
 int main(){
 
-    atomic<bool> done(false);
+    // Season profiles: the built-in 2025 season, or F1_PROFILES=<path> to swap
+    // seasons without recompiling. Every engine shares this one table.
+    string profiles_error;
+    const char* profiles_path = getenv("F1_PROFILES");
+    const shared_ptr<const ProfileTable> profiles = SeasonData::load(profiles_path ? profiles_path : "", profiles_error);
+    if(!profiles) {
+        cerr << "Cannot load profiles: " << profiles_error << "\n";
+        return 1;
+    }
+    const vector<DriverProfile>& drivers = profiles->drivers();
+    // The live race runs the season grid (slot i is driver i in car i), so the driver
+    // ids picked for strategy analysis are also grid slots. Frames carry grid slots;
+    // names and teams are looked up through the grid.
+    const vector<GridEntry> grid = profiles->defaultGrid();
 
-    TrackProfile track = {
-        .track_id = 1,
-        .sectors = 3,
-        .lap_length_km = 10.0f,
-        // Baseline wear multiplier (1.0 ~= "normal"). Higher => earlier pit windows.
-        .tire_wear_factor = 1.0f,
-        .overtaking_difficulty = 0.1f,
-        .safety_car_probability = 0.01f,
-    };
-    
-    // Load 2025 F1 season data
-    const vector<DriverProfile>& drivers = SeasonData::DRIVERS;
-    const vector<CarProfile>& cars = SeasonData::CARS;
+    // Track 1 (the balanced baseline circuit), or the first track defined.
+    const TrackProfile* default_track = profiles->findTrack(1);
+    const TrackProfile track = default_track ? *default_track : profiles->tracks().front();
 
     uint32_t total_laps = 52;
 
+    // Stage threads (F1_EXECUTOR_THREADS, default 2) and where they and the strategy
+    // workers run (F1_AFFINITY / F1_PIPELINE_CPUS / F1_STRATEGY_CPUS, see Topology.h).
+    size_t executor_threads = 2;
+    if(const char* threads = getenv("F1_EXECUTOR_THREADS")) {
+        executor_threads = static_cast<size_t>(max(1, atoi(threads)));
+    }
+    const ThreadPlacement placement = Topology::detect().placementFromEnvironment(executor_threads);
+    placement.describe(cout);
+
     // Ask user about strategy optimization
     cout << "\nRun strategy analysis? (y/n): ";
     string response;
@@ -63,7 +203,7 @@ int main(){
         // Display driver list
         cout << "\nAvailable drivers:\n";
         for(uint32_t i = 0; i < drivers.size(); i++) {
-            cout << i << ": " << drivers[i].driver_id << "\n";
+            cout << i << ": " << profiles->driverName(i) << "\n";
         }
         
         cout << "\nEnter driver IDs to optimize (comma-separated, no spaces): ";
@@ -76,42 +216,79 @@ int main(){
             cout << "No valid driver IDs entered. Skipping strategy analysis.\n";
         } else {
         
-        cout << "\nAnalyzing strategies (this may take 10-30 seconds)...\n";
+        // Several drivers can be optimized together, each plan accounting for the others'.
+        bool joint = false;
+        if(driver_ids.size() > 1) {
+            cout << "Optimize them jointly (each plan accounts for the others' stops and traffic)? (y/n): ";
+            string joint_response;
+            getline(cin, joint_response);
+            joint = (joint_response == "y" || joint_response == "Y");
+        }
+
+        cout << "\nAnalyzing strategies (this may take a few seconds)...\n";
         
         // Run strategy analyzer
-        StrategyAnalyzer analyzer(track, drivers, cars, total_laps);
-        vector<StrategyResult> results = analyzer.analyzeStrategies(driver_ids);
+        StrategyAnalyzer analyzer(track, profiles, total_laps);
+        analyzer.setWorkerCpus(placement.strategy_cpus);
+        vector<StrategyResult> results;
+        if(joint) {
+            JointStrategyResult joint_result = analyzer.analyzeJointStrategies(driver_ids);
+            results = std::move(joint_result.results);
+            cout << "Joint search: " << joint_result.rounds << " round" << (joint_result.rounds == 1 ? "" : "s")
+                << (joint_result.converged ? ", converged" : ", stopped at the round limit")
+                << " (" << joint_result.races_simulated << " races simulated)\n";
+        } else {
+            results = analyzer.analyzeStrategies(driver_ids);
+        }
         
         // Display results
         cout << "\nStrategy Analysis Results:\n";
         cout << "==========================\n";
         for(const auto& result : results) {
-            cout << drivers[result.driver_id].driver_id 
+            cout << profiles->driverName(result.driver_id)
                 << ": Pit lap " << result.optimal_pit_lap 
                 << " (finish time: " << (result.finish_time_seconds / 60.0f) << " min)\n";
             
             // Store for use in live race
             optimal_strategies[result.driver_id] = result.optimal_pit_lap;
         }
+        const StintCache::Stats cache_stats = analyzer.stintCacheStats();
+        cout << "Stint cache: " << cache_stats.hits << " full + " << cache_stats.prefix_hits << " prefix hits / "
+            << (cache_stats.hits + cache_stats.prefix_hits + cache_stats.misses)
+            << " lookups (" << static_cast<int>(cache_stats.hitRate() * 100.0) << "% hit rate)\n";
         cout << "\n";
         } // end else block for non-empty driver_ids
     }
 
-    auto penalty_enforcer = std::make_shared<PenaltyEnforcer>(drivers);
+    auto penalty_enforcer = std::make_shared<PenaltyEnforcer>(grid.size());
 
-    RingBuffer<TelemetryFrame> buffer(1024);
-    TelemetryGenerator generator(track, drivers, cars, total_laps, penalty_enforcer);
-    TrackLimitsMonitor track_limits_monitor(track, drivers, penalty_enforcer);
+    PipelineStats pipeline_stats;
+    TelemetryGenerator generator(track, profiles, grid, total_laps, penalty_enforcer);
+    TrackLimitsMonitor track_limits_monitor(track, profiles, grid, penalty_enforcer, random_device{}());
+    RaceAnalytics race_analytics(grid.size(), track.sectors);
 
     if(!optimal_strategies.empty()) {
         generator.setOptimalStrategies(optimal_strategies);
     }
 
+    // F1_SHM_NAME=/f1-telemetry publishes every tick to a shared-memory ring that
+    // local processes can read in place (see f1-shm-tail).
+    unique_ptr<ShmPublisher> shm;
+    if(const char* shm_name = getenv("F1_SHM_NAME")) {
+        shm = make_unique<ShmPublisher>();
+        if(shm->open(shm_name, 64 * 1024, static_cast<uint32_t>(grid.size()))) {
+            cout << "Publishing telemetry to shared memory " << shm_name << "\n";
+        } else {
+            cerr << "Shared-memory transport disabled: " << shm->error() << "\n";
+            shm.reset();
+        }
+    }
+
     // Print strategies that will be used, then start the race
     cout << "\nRace strategies:\n";
     cout << "================\n";
-    for (uint32_t i = 0; i < drivers.size(); i++) {
-        cout << drivers[i].driver_id << ": ";
+    for (uint32_t i = 0; i < grid.size(); i++) {
+        cout << profiles->driverName(grid[i].driver_index) << ": ";
         auto it = optimal_strategies.find(i);
         if (it != optimal_strategies.end()) {
             cout << "Optimal pit lap " << it->second << "\n";
@@ -127,178 +304,113 @@ int main(){
     }
     cout << "\nStarting race...\n\n";
 
-    thread producer([&]() {
-        while(!done.load()){
-            auto frames = generator.next();
-
-            if(generator.isRaceFinished()) {
-                done.store(true);
-                buffer.shutdown();
-                
-                string winner = "";
-                for(const auto& frame : frames) {
-                    if(frame.race_position == 1) {
-                        winner = drivers[frame.driver_id].driver_id;
-                        break;
-                    }
-                }
-                
-                cout << "\n🏁 RACE FINISHED! 🏁\n";
-                cout << "🏆 Winner: " << winner << " 🏆\n";
-
-                break;
-            }
-
-            for(const auto &frame : frames){
-                if(!buffer.push(frame)){
-                    TelemetryFrame old_frame;
-                    buffer.pop(old_frame);
-                    cout << "[Telemetry] Buffer full, dropping frame " << drivers[old_frame.driver_id].driver_id << "\n";
-                    buffer.push(frame);
-                }
-            }
-            this_thread::sleep_for(chrono::milliseconds(20));
+    // Pipeline counters in Prometheus format, served on localhost (F1_METRICS_PORT=<port>)
+    // and/or rewritten every second (F1_METRICS_FILE=<path>).
+    MetricsExporter metrics_exporter(&pipeline_stats);
+    unique_ptr<MetricsHttpServer> metrics_server;
+    unique_ptr<StatsReporter> metrics_writer;
+    if(const char* metrics_port = getenv("F1_METRICS_PORT")) {
+        metrics_server = make_unique<MetricsHttpServer>(metrics_exporter, static_cast<uint16_t>(atoi(metrics_port)));
+        if(!metrics_server->listening()) {
+            cerr << "Could not listen on 127.0.0.1:" << metrics_port << " for metrics\n";
         }
-    });
-
-    thread consumer([&]() {
-        vector<TelemetryFrame> latestFrames(drivers.size());
-        // Initialize with valid positions to avoid sorting issues on first frames
-        for(size_t i = 0; i < latestFrames.size(); i++) {
-            latestFrames[i].driver_id = static_cast<uint32_t>(i);
-            latestFrames[i].race_position = static_cast<uint8_t>(i + 1);
-            latestFrames[i].lap = 0;
-            latestFrames[i].sector = 1;
+    }
+    if(const char* metrics_file = getenv("F1_METRICS_FILE")) {
+        metrics_writer = make_unique<StatsReporter>(chrono::seconds(1), metrics_file, [&](ostream& os) {
+            metrics_exporter.render(os);
+        });
+    }
+
+    // Calibrate the instrumentation clock before the threads start, and optionally
+    // dump pipeline stats to a file every second (F1_STATS_FILE=<path>).
+    unique_ptr<StatsReporter> stats_reporter;
+    if constexpr (Instrumentation::ENABLED) {
+        CycleClock::ticksPerNs();
+        if(const char* stats_file = getenv("F1_STATS_FILE")) {
+            stats_reporter = make_unique<StatsReporter>(chrono::seconds(1), stats_file, [&](ostream& os) {
+                pipeline_stats.dump(os);
+            });
         }
-        
-        while(!done.load()){
-            TelemetryFrame frame;
+    }
 
-            if(!buffer.pop(frame)) {
-                break;
-            }
+    // Every stage is a coroutine on a small executor. The generator's raw stream is
+    // split into tiers, and each consumer subscribes to the one it needs: analytics
+    // and the recorder take every frame, the leaderboard redraws from the 10 Hz tier,
+    // track limits are checked on sector events, and lap summaries feed the
+    // fastest-lap report.
+    Executor executor(executor_threads);
+    if(!placement.pipeline_cpus.empty()) {
+        executor.setThreadInit([&placement](size_t index) {
+            Topology::pinCurrentThread(placement.pipeline_cpus[index % placement.pipeline_cpus.size()]);
+        });
+    }
 
-            track_limits_monitor.processFrame(frame);
+    // Ring slots live on the pipeline threads' NUMA node (heap when unknown).
+    NumaMemoryResource stage_memory(placement.numa_node);
+    FrameRing generated(1024, executor, &stage_memory);
+    FrameRing full_rate(256, executor, &stage_memory);
+    FrameRing analysed(256, executor, &stage_memory);
+    FrameRing leaderboard(64, executor, &stage_memory);
+    SectorRing sector_events(64, executor, &stage_memory);
+    LapRing lap_summaries(32, executor, &stage_memory);
+    TierDecimator tiers(grid.size(), track.sectors);
+    LapSummary fastest_lap{};
+    TelemetryTable recording;
+    uint32_t winner = 0;
 
-            latestFrames[frame.driver_id] = frame;
-            
-            static size_t frameCount = 0;
-            frameCount++;
-            
-            if(frameCount % drivers.size() == 0) {
-                cout << "\033[2J\033[H";
-                
-                uint32_t currentLap = 0;
-                for(const auto& f : latestFrames) {
-                    if(f.lap > currentLap) currentLap = f.lap;
-                }
-                
-                cout << "\n🏁 LAP " << currentLap << "/" << total_laps << " 🏁\n";
-                cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n";
-                
-                vector<TelemetryFrame> sortedFrames = latestFrames;
-                sort(sortedFrames.begin(), sortedFrames.end(), 
-                        [](const TelemetryFrame& a, const TelemetryFrame& b) {
-                            return a.race_position < b.race_position;
-                        });
-                
-                for(const auto& f : sortedFrames) {
-                    string posColor = "\033[1;33m";
-                    if(f.race_position == 1) posColor = "\033[1;93m";
-                    else if(f.race_position == 2) posColor = "\033[1;37m";
-                    else if(f.race_position == 3) posColor = "\033[1;91m";
-                    
-                    cout << posColor << "P" << int(f.race_position);
-                    if(f.race_position < 10) cout << " ";
-                    cout << "\033[0m ";
-                    
-                    string emoji = "⚫";
-                    string teamName = cars[f.driver_id].car_id;
-                    if(teamName == "Red Bull") emoji = "🔵";
-                    else if(teamName == "Ferrari") emoji = "🔴";
-                    else if(teamName == "Mercedes") emoji = "⚪";
-                    else if(teamName == "McLaren") emoji = "🟠";
-                    else if(teamName == "Aston Martin") emoji = "🟢";
-                    else if(teamName == "Alpine") emoji = "💙";
-                    else if(teamName == "Haas") emoji = "⚪";
-                    else if(teamName == "Racing Bulls") emoji = "🔷";
-                    else if(teamName == "Williams") emoji = "💙";
-                    else if(teamName == "Kick Sauber") emoji = "🟢";
-                    
-                    cout << emoji << " ";
-                    
-                    string name = drivers[f.driver_id].driver_id;
-                    cout << "\033[1m" << name << "\033[0m";
-                    for(size_t i = name.length(); i < 20; i++) cout << " ";
-                    
-                    int barLength = 10;
-                    float progress = (f.sector - 1) / float(track.sectors);
-                    int filled = int(progress * barLength);
-                    cout << " ";
-                    for(int i = 0; i < barLength; i++) {
-                        if(i < filled) cout << "█";
-                        else cout << "░";
-                    }
-                    
-                    cout << " Lap " << f.lap;
-                    
-                    if(f.speed_kph == 0.0f) {
-                        cout << "  \033[1;35m[IN PITS]\033[0m";
-                    } else {
-                        string speedColor = "\033[32m";
-                        if(f.speed_kph < 150) speedColor = "\033[31m";
-                        else if(f.speed_kph < 200) speedColor = "\033[33m";
-                        
-                        cout << "  Speed: " << speedColor << int(f.speed_kph) << " kph\033[0m";
-                    }
-                    
-                    float tirePercent = f.tire_wear * 100;
-                    string tireColor = "\033[32m";
-                    if(tirePercent > 70) tireColor = "\033[31m";
-                    else if(tirePercent > 40) tireColor = "\033[33m";
-                    
-                    cout << "  Tire: " << tireColor << int(tirePercent) << "%\033[0m";
-                    
-                    cout << "\n";
-                }
-                
-                cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n";
-                
-                cout << "\n⚠️  TRACK LIMITS VIOLATIONS:\n";
-                bool any_violations = false;
-                for(const auto& f : sortedFrames) {
-                    TrackLimitsState state = track_limits_monitor.getDriverState(f.driver_id);
-                    DriverPenaltyInfo penalty = penalty_enforcer->getPenaltyInfo(f.driver_id);
-                    
-                    if(state.warnings > 0) {
-                        any_violations = true;
-                        cout << "   " << drivers[f.driver_id].driver_id << ": ";
-                        cout << state.warnings << " warning" << (state.warnings > 1 ? "s" : "");
-                        
-                        // Add penalty status
-                        if(penalty.state == PenaltyState::PENDING) {
-                            cout << " \033[1;33m[PENALTY PENDING]\033[0m";
-                        } else if(penalty.state == PenaltyState::SERVING) {
-                            cout << " \033[1;31m[SERVING PENALTY]\033[0m";
-                        } else if(penalty.state == PenaltyState::SERVED) {
-                            cout << " \033[1;32m[PENALTY SERVED]\033[0m";
-                        }
-                        cout << "\n";
-                    }
-                }
+    Leaderboard board(profiles, grid, track, total_laps, race_analytics, track_limits_monitor, penalty_enforcer, &pipeline_stats);
+    // A redraw follows every grid's worth of frames, so this never grows past its reserve.
+    vector<uint64_t> awaiting_render;
+    awaiting_render.reserve(grid.size());
+    auto render = [&](const TelemetryFrame& frame) {
+        Instrumentation::onDisplayed(awaiting_render, frame);
+        if(board.update(frame)) {
+            board.render(cout);
+            Instrumentation::onRendered(pipeline_stats, awaiting_render);
+            Metrics::increment(Counter::LEADERBOARD_REDRAWS);
+        }
+    };
 
-                if(!any_violations) {
-                    cout << "   \033[90mNone\033[0m\n";
-                }
-                
-                cout << "\033[90mRace runs until finish\033[0m\n";
-                cout.flush();
-            }
+    executor.spawn(generatorStage(executor, generator, generated, shm.get(), pipeline_stats, winner));
+    executor.spawn(tierStage(generated, tiers, {&full_rate, &leaderboard, &sector_events, &lap_summaries}, pipeline_stats));
+    executor.spawn(frameStage(full_rate, &analysed, [&](const TelemetryFrame& frame) {
+        race_analytics.processFrame(frame);
+    }));
+    executor.spawn(frameStage(analysed, nullptr, [&](const TelemetryFrame& frame) {
+        recording.append(frame);
+    }));
+    executor.spawn(eventStage(sector_events, [&](const SectorEvent& event) {
+        track_limits_monitor.processSectorEvent(event);
+    }));
+    executor.spawn(eventStage(lap_summaries, [&](const LapSummary& lap) {
+        if(lap.lap_time_s > 0.0f && (fastest_lap.lap_time_s == 0.0f || lap.lap_time_s < fastest_lap.lap_time_s)) {
+            fastest_lap = lap;
         }
-    });
+    }));
+    executor.spawn(frameStage(leaderboard, nullptr, std::move(render)));
+
+    // Returns once the generator has finished the race and every stage has drained.
+    executor.run();
 
-    producer.join();
-    consumer.join();
+    cout << "\n🏁 RACE FINISHED! 🏁\n";
+    cout << "🏆 Winner: " << profiles->driverName(grid[winner].driver_index) << " 🏆\n";
+    if(fastest_lap.lap_time_s > 0.0f) {
+        cout << "⏱️  Fastest lap: " << profiles->driverName(grid[fastest_lap.driver_id].driver_index) << ", lap " << fastest_lap.lap
+             << " in " << fastest_lap.lap_time_s << "s\n";
+    }
+    cout << "\nRecorded " << recording.rowCount() << " frames in " << recording.chunkCount() << " chunks\n";
+    cout << "Streams: " << tiers.emitted(StreamTier::FULL) << " frames at full rate, "
+         << tiers.emitted(StreamTier::HZ10) << " at 10 Hz, "
+         << tiers.emitted(StreamTier::SECTOR) << " sector events, "
+         << tiers.emitted(StreamTier::LAP) << " lap summaries\n";
+
+    cout << "\nRace analytics:\n";
+    race_analytics.dump(cout, *profiles, grid);
+
+    if constexpr (Instrumentation::ENABLED) {
+        cout << "\nPipeline latency:\n";
+        pipeline_stats.dump(cout);
+    }
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Cheap monotonic timestamps for instrumentation. On x86 this reads the (invariant)
+// TSC, which costs a few nanoseconds instead of a full steady_clock::now(); elsewhere
+// it falls back to steady_clock nanoseconds. Convert tick deltas with ticksPerNs().
+namespace CycleClock {
+    inline uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    // Calibrated once on first use (~10 ms); only call this off the hot path.
+    inline double ticksPerNs() {
+#if defined(__x86_64__) || defined(__i386__)
+        static const double ratio = []() {
+            using namespace std::chrono;
+            const auto wall_start = steady_clock::now();
+            const uint64_t tsc_start = now();
+            std::this_thread::sleep_for(milliseconds(10));
+            const uint64_t tsc_end = now();
+            const auto wall_ns = duration_cast<nanoseconds>(steady_clock::now() - wall_start).count();
+            return wall_ns > 0 ? static_cast<double>(tsc_end - tsc_start) / static_cast<double>(wall_ns) : 1.0;
+        }();
+        return ratio;
+#else
+        return 1.0;
+#endif
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "../common/types.h"
+#include "CycleClock.h"
+#include "PipelineStats.h"
+#include <span>
+#include <vector>
+
+// Frame latency hooks for the live pipeline. Frames are stamped at generation and
+// push; pop, processing and render times are recorded into PipelineStats. When built without
+// F1_INSTRUMENTATION the stamp fields do not exist and every hook is an empty inline
+// function, so call sites compile to nothing.
+//
+// Latency is sampled: one frame in SAMPLE_EVERY (rotating across drivers tick by tick)
+// carries stamps, which keeps the per-frame cost to a branch for unsampled frames.
+// Unsampled frames have generated_at_ticks == 0.
+namespace Instrumentation {
+#ifdef F1_INSTRUMENTATION
+    constexpr bool ENABLED = true;
+
+#ifdef F1_INSTRUMENTATION_SAMPLE_EVERY
+    constexpr uint64_t SAMPLE_EVERY = F1_INSTRUMENTATION_SAMPLE_EVERY;
+#else
+    constexpr uint64_t SAMPLE_EVERY = 4;
+#endif
+    static_assert(SAMPLE_EVERY > 0, "SAMPLE_EVERY must be positive");
+
+    inline uint64_t now() {
+        return CycleClock::now();
+    }
+
+    // One clock read per tick, shared by the sampled frames of that tick.
+    inline void stampGenerated(std::span<TelemetryFrame> frames, uint64_t tick) {
+        const uint64_t t = now();
+        for(size_t i = 0; i < frames.size(); i++) {
+            frames[i].generated_at_ticks = ((tick + i) % SAMPLE_EVERY == 0) ? t : 0;
+            frames[i].pushed_at_ticks = 0;
+        }
+    }
+
+    inline void onPush(PipelineStats& stats, TelemetryFrame& frame, uint64_t t) {
+        if(frame.generated_at_ticks == 0) return;
+        frame.pushed_at_ticks = t;
+        stats.record(PipelineStage::PRODUCER, t - frame.generated_at_ticks);
+    }
+
+    // Returns the pop time for sampled frames, 0 otherwise (no clock read).
+    inline uint64_t onPop(PipelineStats& stats, const TelemetryFrame& frame) {
+        if(frame.generated_at_ticks == 0) return 0;
+        const uint64_t t = now();
+        stats.record(PipelineStage::RING, t - frame.pushed_at_ticks);
+        return t;
+    }
+
+    inline void onProcessed(PipelineStats& stats, const TelemetryFrame& frame, uint64_t popped_at) {
+        if(popped_at == 0) return;
+        const uint64_t t = now();
+        stats.record(PipelineStage::CONSUMER, t - popped_at);
+    }
+
+    // A display keeps the generation stamps of the sampled frames it was handed
+    // since its last redraw, and records their age once the redraw is out.
+    inline void onDisplayed(std::vector<uint64_t>& pending, const TelemetryFrame& frame) {
+        if(frame.generated_at_ticks != 0) pending.push_back(frame.generated_at_ticks);
+    }
+
+    inline void onRendered(PipelineStats& stats, std::vector<uint64_t>& pending) {
+        if(pending.empty()) return;
+        const uint64_t t = now();
+        for(uint64_t generated_at : pending) {
+            stats.record(PipelineStage::END_TO_END, t - generated_at);
+        }
+        pending.clear();
+    }
+
+    // Records how far this tick started from `period_ticks` after the previous one.
+    inline void onTick(PipelineStats& stats, uint64_t& last_tick_at, uint64_t period_ticks) {
+        const uint64_t t = now();
+        if(last_tick_at != 0) {
+            const uint64_t interval = t - last_tick_at;
+            stats.record(PipelineStage::TICK_JITTER, interval > period_ticks ? interval - period_ticks : period_ticks - interval);
+        }
+        last_tick_at = t;
+    }
+
+    inline void onOccupancy(PipelineStats& stats, size_t depth) {
+        stats.recordOccupancy(depth);
+    }
+#else
+    constexpr bool ENABLED = false;
+
+    inline uint64_t now() { return 0; }
+    inline void stampGenerated(std::span<TelemetryFrame>, uint64_t) {}
+    inline void onPush(PipelineStats&, TelemetryFrame&, uint64_t) {}
+    inline uint64_t onPop(PipelineStats&, const TelemetryFrame&) { return 0; }
+    inline void onProcessed(PipelineStats&, const TelemetryFrame&, uint64_t) {}
+    inline void onDisplayed(std::vector<uint64_t>&, const TelemetryFrame&) {}
+    inline void onRendered(PipelineStats&, std::vector<uint64_t>&) {}
+    inline void onTick(PipelineStats&, uint64_t&, uint64_t) {}
+    inline void onOccupancy(PipelineStats&, size_t) {}
+#endif
+}
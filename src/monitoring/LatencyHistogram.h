@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+// HDR-style log-linear histogram: values below 16 are exact, above that every power
+// of two is split into 16 linear sub-buckets (~6% worst-case relative error), which
+// covers the full uint64_t range in 976 buckets.
+//
+// record() is meant for a single writer per histogram (each pipeline stage is only
+// recorded from one thread) and uses a relaxed load/store instead of a locked RMW.
+// Readers may snapshot concurrently from any thread without blocking the writer.
+class LatencyHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 4;
+    static constexpr uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    struct Snapshot {
+        std::array<uint64_t, BUCKET_COUNT> counts{};
+        uint64_t total = 0;
+
+        // Value at quantile q in [0, 1] (lower bound of the containing bucket).
+        uint64_t percentile(double q) const {
+            if(total == 0) return 0;
+            uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+            uint64_t seen = 0;
+            for(size_t i = 0; i < BUCKET_COUNT; i++) {
+                seen += counts[i];
+                if(seen >= rank) return bucketLowerBound(i);
+            }
+            return bucketLowerBound(BUCKET_COUNT - 1);
+        }
+
+        uint64_t max() const {
+            for(size_t i = BUCKET_COUNT; i > 0; i--) {
+                if(counts[i - 1] != 0) return bucketLowerBound(i - 1);
+            }
+            return 0;
+        }
+    };
+
+    void record(uint64_t value) {
+        auto& bucket = counts_[bucketIndex(value)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    Snapshot snapshot() const {
+        Snapshot s;
+        for(size_t i = 0; i < BUCKET_COUNT; i++) {
+            s.counts[i] = counts_[i].load(std::memory_order_relaxed);
+            s.total += s.counts[i];
+        }
+        return s;
+    }
+
+    static size_t bucketIndex(uint64_t value) {
+        if(value < SUB_BUCKETS) return static_cast<size_t>(value);
+        const uint32_t exponent = 63 - static_cast<uint32_t>(__builtin_clzll(value));
+        const uint32_t sub = static_cast<uint32_t>(value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+        return static_cast<size_t>(exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+    }
+
+    static uint64_t bucketLowerBound(size_t index) {
+        if(index < SUB_BUCKETS) return index;
+        const uint32_t exponent = static_cast<uint32_t>(index / SUB_BUCKETS) + SUB_BUCKET_BITS - 1;
+        const uint64_t sub = index % SUB_BUCKETS;
+        return (SUB_BUCKETS + sub) << (exponent - SUB_BUCKET_BITS);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts_{};
+};
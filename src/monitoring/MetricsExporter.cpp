@@ -0,0 +1,154 @@
+#include "MetricsExporter.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstring>
+#include <sstream>
+
+using namespace std;
+
+MetricsExporter::MetricsExporter(const PipelineStats* pipeline_stats) : pipeline_stats_(pipeline_stats) {}
+
+void MetricsExporter::render(ostream& os) const {
+    MetricsSnapshot s = MetricsRegistry::instance().snapshot();
+
+    for(size_t i = 0; i < COUNTER_COUNT; i++) {
+        const Counter c = static_cast<Counter>(i);
+        const char* name = MetricsRegistry::counterName(c);
+        os << "# HELP " << name << " " << MetricsRegistry::counterHelp(c) << "\n";
+        os << "# TYPE " << name << " counter\n";
+        os << name << " " << s.counters[i] << "\n";
+    }
+
+    for(size_t i = 0; i < GAUGE_COUNT; i++) {
+        const Gauge g = static_cast<Gauge>(i);
+        const char* name = MetricsRegistry::gaugeName(g);
+        os << "# HELP " << name << " " << MetricsRegistry::gaugeHelp(g) << "\n";
+        os << "# TYPE " << name << " gauge\n";
+        os << name << " " << s.gauges[i] << "\n";
+    }
+
+    if(pipeline_stats_) {
+        PipelineStatsSnapshot p = pipeline_stats_->snapshot();
+
+        os << "# HELP f1_ring_high_water Highest ring buffer depth observed.\n";
+        os << "# TYPE f1_ring_high_water gauge\n";
+        os << "f1_ring_high_water " << p.ring_high_water << "\n";
+
+        os << "# HELP f1_frame_latency_seconds Sampled per-stage frame latency.\n";
+        os << "# TYPE f1_frame_latency_seconds summary\n";
+        for(size_t i = 0; i < PIPELINE_STAGE_COUNT; i++) {
+            const auto& st = p.stages[i];
+            const char* stage = PipelineStats::stageName(static_cast<PipelineStage>(i));
+            os << "f1_frame_latency_seconds{stage=\"" << stage << "\",quantile=\"0.5\"} " << st.p50_ns * 1e-9 << "\n";
+            os << "f1_frame_latency_seconds{stage=\"" << stage << "\",quantile=\"0.9\"} " << st.p90_ns * 1e-9 << "\n";
+            os << "f1_frame_latency_seconds{stage=\"" << stage << "\",quantile=\"0.99\"} " << st.p99_ns * 1e-9 << "\n";
+            os << "f1_frame_latency_seconds{stage=\"" << stage << "\",quantile=\"0.999\"} " << st.p999_ns * 1e-9 << "\n";
+            os << "f1_frame_latency_seconds_count{stage=\"" << stage << "\"} " << st.count << "\n";
+        }
+    }
+}
+
+string MetricsExporter::render() const {
+    ostringstream os;
+    render(os);
+    return os.str();
+}
+
+MetricsHttpServer::MetricsHttpServer(const MetricsExporter& exporter, uint16_t port)
+    : exporter_(exporter), listen_fd_(-1), port_(0), stop_(false) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if(fd < 0) return;
+
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+
+    if(bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, 8) != 0) {
+        close(fd);
+        return;
+    }
+
+    socklen_t len = sizeof(addr);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+    listen_fd_ = fd;
+
+    thread_ = thread([this]() { run(); });
+}
+
+MetricsHttpServer::~MetricsHttpServer() {
+    stop_.store(true);
+    if(thread_.joinable()) thread_.join();
+    if(listen_fd_ >= 0) close(listen_fd_);
+}
+
+bool MetricsHttpServer::listening() const {
+    return listen_fd_ >= 0;
+}
+
+uint16_t MetricsHttpServer::port() const {
+    return port_;
+}
+
+void MetricsHttpServer::run() {
+    pollfd pfd{listen_fd_, POLLIN, 0};
+
+    while(!stop_.load()) {
+        // Short timeout so shutdown is noticed promptly.
+        if(poll(&pfd, 1, 200) <= 0) continue;
+
+        int client = accept(listen_fd_, nullptr, nullptr);
+        if(client < 0) continue;
+        handleConnection(client);
+        close(client);
+    }
+}
+
+void MetricsHttpServer::handleConnection(int fd) {
+    char request[1024];
+    size_t received = 0;
+
+    // Read until the end of the request headers (or the buffer is full).
+    pollfd pfd{fd, POLLIN, 0};
+    while(received < sizeof(request) - 1 && poll(&pfd, 1, 1000) > 0) {
+        ssize_t n = recv(fd, request + received, sizeof(request) - 1 - received, 0);
+        if(n <= 0) break;
+        received += static_cast<size_t>(n);
+        request[received] = '\0';
+        if(strstr(request, "\r\n\r\n")) break;
+    }
+    request[received] = '\0';
+
+    string body;
+    const char* status = "200 OK";
+    const char* content_type = "text/plain; version=0.0.4";
+    if(strncmp(request, "GET /metrics", 12) == 0) {
+        body = exporter_.render();
+    } else {
+        status = "404 Not Found";
+        content_type = "text/plain";
+        body = "not found\n";
+    }
+
+    ostringstream response;
+    response << "HTTP/1.0 " << status << "\r\n"
+             << "Content-Type: " << content_type << "\r\n"
+             << "Content-Length: " << body.size() << "\r\n"
+             << "Connection: close\r\n\r\n"
+             << body;
+    const string out = response.str();
+
+    size_t sent = 0;
+    while(sent < out.size()) {
+        ssize_t n = send(fd, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+        if(n <= 0) break;
+        sent += static_cast<size_t>(n);
+    }
+}
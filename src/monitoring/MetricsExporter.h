@@ -0,0 +1,47 @@
+#pragma once
+
+#include "MetricsRegistry.h"
+#include "PipelineStats.h"
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <thread>
+
+// Renders the metrics registry (and, optionally, pipeline latency quantiles) in the
+// Prometheus text exposition format (version 0.0.4).
+class MetricsExporter {
+public:
+    explicit MetricsExporter(const PipelineStats* pipeline_stats = nullptr);
+
+    void render(std::ostream& os) const;
+    std::string render() const;
+
+private:
+    const PipelineStats* pipeline_stats_;
+};
+
+// Minimal HTTP/1.0 listener bound to 127.0.0.1 that serves GET /metrics.
+// Connections are handled one at a time on a single background thread; a scrape
+// never touches the hot path beyond reading the registry.
+class MetricsHttpServer {
+public:
+    MetricsHttpServer(const MetricsExporter& exporter, uint16_t port);
+    ~MetricsHttpServer();
+
+    MetricsHttpServer(const MetricsHttpServer&) = delete;
+    MetricsHttpServer& operator=(const MetricsHttpServer&) = delete;
+
+    bool listening() const;
+    uint16_t port() const;
+
+private:
+    const MetricsExporter& exporter_;
+    int listen_fd_;
+    uint16_t port_;
+    std::atomic<bool> stop_;
+    std::thread thread_;
+
+    void run();
+    void handleConnection(int fd);
+};
@@ -0,0 +1,87 @@
+#include "MetricsRegistry.h"
+
+using namespace std;
+
+MetricsRegistry& MetricsRegistry::instance() {
+    // Never destroyed: thread-exit hooks of late threads may still release blocks.
+    static MetricsRegistry* registry = new MetricsRegistry();
+    return *registry;
+}
+
+MetricsRegistry::CounterBlock* MetricsRegistry::acquireBlock() {
+    lock_guard<mutex> lock(mutex_);
+    if(!free_blocks_.empty()) {
+        CounterBlock* block = free_blocks_.back();
+        free_blocks_.pop_back();
+        return block;
+    }
+    blocks_.push_back(make_unique<CounterBlock>());
+    return blocks_.back().get();
+}
+
+void MetricsRegistry::releaseBlock(CounterBlock* block) {
+    lock_guard<mutex> lock(mutex_);
+    for(size_t i = 0; i < COUNTER_COUNT; i++) {
+        retired_[i] += block->values[i].load(memory_order_relaxed);
+        block->values[i].store(0, memory_order_relaxed);
+    }
+    free_blocks_.push_back(block);
+}
+
+MetricsSnapshot MetricsRegistry::snapshot() const {
+    MetricsSnapshot s;
+
+    lock_guard<mutex> lock(mutex_);
+    s.counters = retired_;
+    for(const auto& block : blocks_) {
+        for(size_t i = 0; i < COUNTER_COUNT; i++) {
+            s.counters[i] += block->values[i].load(memory_order_relaxed);
+        }
+    }
+    for(size_t i = 0; i < GAUGE_COUNT; i++) {
+        s.gauges[i] = gauges_[i].load(memory_order_relaxed);
+    }
+    return s;
+}
+
+const char* MetricsRegistry::counterName(Counter c) {
+    switch(c) {
+        case Counter::TICKS_GENERATED: return "f1_ticks_generated_total";
+        case Counter::FRAMES_PUSHED: return "f1_frames_pushed_total";
+        case Counter::FRAMES_POPPED: return "f1_frames_popped_total";
+        case Counter::LEADERBOARD_REDRAWS: return "f1_leaderboard_redraws_total";
+        case Counter::STRATEGY_JOBS_COMPLETED: return "f1_strategy_jobs_completed_total";
+        case Counter::PENALTIES_ISSUED: return "f1_penalties_issued_total";
+        case Counter::STINT_CACHE_HITS: return "f1_stint_cache_hits_total";
+        case Counter::STINT_CACHE_MISSES: return "f1_stint_cache_misses_total";
+    }
+    return "f1_unknown_total";
+}
+
+const char* MetricsRegistry::counterHelp(Counter c) {
+    switch(c) {
+        case Counter::TICKS_GENERATED: return "Simulation ticks generated by telemetry generators.";
+        case Counter::FRAMES_PUSHED: return "Telemetry frames pushed into the ring buffer.";
+        case Counter::FRAMES_POPPED: return "Telemetry frames popped from the generator ring by the tier stage.";
+        case Counter::LEADERBOARD_REDRAWS: return "Live leaderboard redraws (from the 10 Hz tier).";
+        case Counter::STRATEGY_JOBS_COMPLETED: return "Strategy race simulations completed.";
+        case Counter::PENALTIES_ISSUED: return "Time penalties issued by race control.";
+        case Counter::STINT_CACHE_HITS: return "Strategy stint lookups answered wholly or partly (a cached prefix) from the stint cache.";
+        case Counter::STINT_CACHE_MISSES: return "Strategy stint lookups with nothing cached, simulated from the first lap.";
+    }
+    return "";
+}
+
+const char* MetricsRegistry::gaugeName(Gauge g) {
+    switch(g) {
+        case Gauge::RING_DEPTH: return "f1_ring_depth";
+    }
+    return "f1_unknown";
+}
+
+const char* MetricsRegistry::gaugeHelp(Gauge g) {
+    switch(g) {
+        case Gauge::RING_DEPTH: return "Frames currently queued in the ring buffer.";
+    }
+    return "";
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+enum class Counter : uint32_t {
+    TICKS_GENERATED,
+    FRAMES_PUSHED,
+    FRAMES_POPPED,
+    LEADERBOARD_REDRAWS,
+    STRATEGY_JOBS_COMPLETED,
+    PENALTIES_ISSUED,
+    STINT_CACHE_HITS,
+    STINT_CACHE_MISSES,
+};
+
+enum class Gauge : uint32_t {
+    RING_DEPTH,
+};
+
+constexpr size_t COUNTER_COUNT = 8;
+constexpr size_t GAUGE_COUNT = 1;
+
+struct MetricsSnapshot {
+    std::array<uint64_t, COUNTER_COUNT> counters{};
+    std::array<int64_t, GAUGE_COUNT> gauges{};
+};
+
+// Process-wide pipeline counters. Every thread increments its own cache-line-aligned
+// block, so the hot path is a single relaxed atomic update with no sharing between
+// threads; blocks are summed when the registry is scraped. When a thread exits its
+// counts are folded into a retired total and the block is recycled, so short-lived
+// threads (e.g. strategy tasks) do not grow the registry.
+class MetricsRegistry {
+public:
+    struct alignas(64) CounterBlock {
+        std::array<std::atomic<uint64_t>, COUNTER_COUNT> values{};
+    };
+
+    static MetricsRegistry& instance();
+
+    CounterBlock* acquireBlock();
+    void releaseBlock(CounterBlock* block);
+
+    std::atomic<int64_t>& gauge(Gauge g) { return gauges_[static_cast<size_t>(g)]; }
+
+    MetricsSnapshot snapshot() const;
+
+    static const char* counterName(Counter c);
+    static const char* counterHelp(Counter c);
+    static const char* gaugeName(Gauge g);
+    static const char* gaugeHelp(Gauge g);
+
+private:
+    MetricsRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<CounterBlock>> blocks_;
+    std::vector<CounterBlock*> free_blocks_;
+    std::array<uint64_t, COUNTER_COUNT> retired_{};
+
+    std::array<std::atomic<int64_t>, GAUGE_COUNT> gauges_{};
+};
+
+namespace Metrics {
+    namespace detail {
+        struct ThreadBlock {
+            MetricsRegistry::CounterBlock* block;
+
+            ThreadBlock() : block(MetricsRegistry::instance().acquireBlock()) {}
+            ~ThreadBlock() { MetricsRegistry::instance().releaseBlock(block); }
+        };
+
+        inline MetricsRegistry::CounterBlock& threadBlock() {
+            thread_local ThreadBlock tb;
+            return *tb.block;
+        }
+    }
+
+    // Only the owning thread writes its block, so load + store is a safe increment.
+    inline void increment(Counter c, uint64_t n = 1) {
+        auto& value = detail::threadBlock().values[static_cast<size_t>(c)];
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    inline void set(Gauge g, int64_t value) {
+        MetricsRegistry::instance().gauge(g).store(value, std::memory_order_relaxed);
+    }
+}
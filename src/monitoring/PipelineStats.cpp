@@ -0,0 +1,99 @@
+#include "PipelineStats.h"
+#include "CycleClock.h"
+#include <fstream>
+#include <iomanip>
+#include <cstdio>
+
+using namespace std;
+
+void PipelineStats::record(PipelineStage stage, uint64_t ticks) {
+    histograms_[static_cast<size_t>(stage)].record(ticks);
+}
+
+void PipelineStats::recordOccupancy(size_t depth) {
+    // Producer is the only writer, so a plain load/store keeps the high-water mark exact.
+    ring_depth_.store(depth, memory_order_relaxed);
+    if(depth > ring_high_water_.load(memory_order_relaxed)) {
+        ring_high_water_.store(depth, memory_order_relaxed);
+    }
+}
+
+PipelineStatsSnapshot PipelineStats::snapshot() const {
+    const double ns_per_tick = 1.0 / CycleClock::ticksPerNs();
+
+    PipelineStatsSnapshot s{};
+    for(size_t i = 0; i < PIPELINE_STAGE_COUNT; i++) {
+        LatencyHistogram::Snapshot h = histograms_[i].snapshot();
+        s.stages[i] = {
+            h.total,
+            h.percentile(0.50) * ns_per_tick,
+            h.percentile(0.90) * ns_per_tick,
+            h.percentile(0.99) * ns_per_tick,
+            h.percentile(0.999) * ns_per_tick,
+            h.max() * ns_per_tick,
+        };
+    }
+    s.ring_depth = ring_depth_.load(memory_order_relaxed);
+    s.ring_high_water = ring_high_water_.load(memory_order_relaxed);
+    return s;
+}
+
+const char* PipelineStats::stageName(PipelineStage stage) {
+    switch(stage) {
+        case PipelineStage::PRODUCER: return "producer";
+        case PipelineStage::RING: return "ring";
+        case PipelineStage::CONSUMER: return "consumer";
+        case PipelineStage::END_TO_END: return "end_to_end";
+        case PipelineStage::TICK_JITTER: return "tick_jitter";
+    }
+    return "unknown";
+}
+
+void PipelineStats::dump(ostream& os) const {
+    PipelineStatsSnapshot s = snapshot();
+
+    os << "stage          count        p50_us     p90_us     p99_us    p99.9_us     max_us\n";
+    os << fixed << setprecision(2);
+    for(size_t i = 0; i < PIPELINE_STAGE_COUNT; i++) {
+        const auto& st = s.stages[i];
+        os << left << setw(12) << stageName(static_cast<PipelineStage>(i)) << right
+           << setw(9) << st.count
+           << setw(14) << st.p50_ns / 1000.0
+           << setw(11) << st.p90_ns / 1000.0
+           << setw(11) << st.p99_ns / 1000.0
+           << setw(12) << st.p999_ns / 1000.0
+           << setw(11) << st.max_ns / 1000.0 << "\n";
+    }
+    os << "ring depth " << s.ring_depth << ", high-water " << s.ring_high_water << "\n";
+    os << defaultfloat;
+}
+
+StatsReporter::StatsReporter(chrono::milliseconds interval, const string& path, function<void(ostream&)> write)
+    : interval_(interval), path_(path), write_(std::move(write)), stop_(false) {
+    thread_ = thread([this]() { run(); });
+}
+
+StatsReporter::~StatsReporter() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+}
+
+void StatsReporter::run() {
+    const string tmp_path = path_ + ".tmp";
+
+    unique_lock<mutex> lock(mutex_);
+    while(!stop_) {
+        cv_.wait_for(lock, interval_, [this]() { return stop_; });
+
+        {
+            ofstream out(tmp_path, ios::trunc);
+            if(!out) continue;
+            write_(out);
+        }
+        rename(tmp_path.c_str(), path_.c_str());
+    }
+}
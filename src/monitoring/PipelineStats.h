@@ -0,0 +1,82 @@
+#pragma once
+
+#include "LatencyHistogram.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+enum class PipelineStage {
+    PRODUCER,    // generated -> pushed into the ring
+    RING,        // pushed -> popped (ring residency)
+    CONSUMER,    // popped -> processed
+    END_TO_END,  // generated -> rendered on the leaderboard (frame age at render time)
+    TICK_JITTER, // |tick interval - tick period|, one sample per producer tick
+};
+
+constexpr size_t PIPELINE_STAGE_COUNT = 5;
+
+struct StageSummary {
+    uint64_t count;
+    double p50_ns;
+    double p90_ns;
+    double p99_ns;
+    double p999_ns;
+    double max_ns;
+};
+
+struct PipelineStatsSnapshot {
+    std::array<StageSummary, PIPELINE_STAGE_COUNT> stages;
+    uint64_t ring_depth;
+    uint64_t ring_high_water;
+};
+
+// In-process latency and ring statistics for the producer -> ring -> consumer path.
+// Each stage histogram has a single writer (the thread that owns that stage); the
+// occupancy gauges are written by the producer. Any thread may
+// take a snapshot at any time.
+class PipelineStats {
+public:
+    void record(PipelineStage stage, uint64_t ticks);
+    void recordOccupancy(size_t depth);
+
+    PipelineStatsSnapshot snapshot() const;
+    void dump(std::ostream& os) const;
+
+    static const char* stageName(PipelineStage stage);
+
+private:
+    std::array<LatencyHistogram, PIPELINE_STAGE_COUNT> histograms_;
+    std::atomic<uint64_t> ring_depth_{0};
+    std::atomic<uint64_t> ring_high_water_{0};
+};
+
+// Periodically rewrites `path` from a background thread using `write` (e.g. a
+// PipelineStats dump or a metrics exposition). The file is replaced atomically so
+// readers never see a partial write.
+class StatsReporter {
+public:
+    StatsReporter(std::chrono::milliseconds interval, const std::string& path, std::function<void(std::ostream&)> write);
+    ~StatsReporter();
+
+    StatsReporter(const StatsReporter&) = delete;
+    StatsReporter& operator=(const StatsReporter&) = delete;
+
+private:
+    std::chrono::milliseconds interval_;
+    std::string path_;
+    std::function<void(std::ostream&)> write_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_;
+    std::thread thread_;
+
+    void run();
+};
@@ -0,0 +1,440 @@
+#include "QueryEngine.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+using namespace std;
+
+namespace {
+
+// GCC/Clang vector extensions sized to the target's native register: 8 lanes with
+// AVX (e.g. -march=native), 4 lanes (SSE2/NEON) otherwise. Wider-than-native
+// vectors get split through memory and run slower than scalar code.
+#if defined(__AVX__)
+constexpr size_t LANES = 8;
+#else
+constexpr size_t LANES = 4;
+#endif
+constexpr size_t CHUNK_ROWS = TelemetryTable::CHUNK_ROWS;
+static_assert(CHUNK_ROWS % LANES == 0, "chunks must hold whole vectors");
+
+#if defined(__GNUC__)
+using f32xN = float __attribute__((vector_size(LANES * sizeof(float))));
+using i32xN = int32_t __attribute__((vector_size(LANES * sizeof(int32_t))));
+
+inline f32xN load(const float* p) {
+    f32xN v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline i32xN loadMask(const int32_t* p) {
+    i32xN v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void storeMask(int32_t* p, i32xN v) {
+    memcpy(p, &v, sizeof(v));
+}
+
+inline f32xN broadcast(float value) {
+    f32xN v;
+    for(size_t l = 0; l < LANES; l++) v[l] = value;
+    return v;
+}
+#endif
+
+enum class ZoneVerdict {
+    NONE,   // no row in the chunk can match
+    SOME,
+    ALL,    // every row matches; the predicate need not be evaluated
+};
+
+ZoneVerdict classify(const TelemetryTable::ZoneMap& zone, const Predicate& p) {
+    const float v = p.value;
+    switch(p.op) {
+        case CompareOp::LT:
+            if(zone.min >= v) return ZoneVerdict::NONE;
+            if(zone.max < v) return ZoneVerdict::ALL;
+            break;
+        case CompareOp::LE:
+            if(zone.min > v) return ZoneVerdict::NONE;
+            if(zone.max <= v) return ZoneVerdict::ALL;
+            break;
+        case CompareOp::GT:
+            if(zone.max <= v) return ZoneVerdict::NONE;
+            if(zone.min > v) return ZoneVerdict::ALL;
+            break;
+        case CompareOp::GE:
+            if(zone.max < v) return ZoneVerdict::NONE;
+            if(zone.min >= v) return ZoneVerdict::ALL;
+            break;
+        case CompareOp::EQ:
+            if(v < zone.min || v > zone.max) return ZoneVerdict::NONE;
+            if(zone.min == v && zone.max == v) return ZoneVerdict::ALL;
+            break;
+    }
+    return ZoneVerdict::SOME;
+}
+
+// mask[i] = (first ? -1 : mask[i]) & (col[i] OP value), over whole vectors.
+template<CompareOp OP>
+void compareKernel(const float* col, float value, int32_t* mask, size_t padded, bool first) {
+#if defined(__GNUC__)
+    const f32xN s = broadcast(value);
+    for(size_t i = 0; i < padded; i += LANES) {
+        const f32xN x = load(col + i);
+        i32xN m;
+        if constexpr (OP == CompareOp::LT) m = x < s;
+        else if constexpr (OP == CompareOp::LE) m = x <= s;
+        else if constexpr (OP == CompareOp::GT) m = x > s;
+        else if constexpr (OP == CompareOp::GE) m = x >= s;
+        else m = x == s;
+        if(!first) m &= loadMask(mask + i);
+        storeMask(mask + i, m);
+    }
+#else
+    for(size_t i = 0; i < padded; i++) {
+        bool hit;
+        if constexpr (OP == CompareOp::LT) hit = col[i] < value;
+        else if constexpr (OP == CompareOp::LE) hit = col[i] <= value;
+        else if constexpr (OP == CompareOp::GT) hit = col[i] > value;
+        else if constexpr (OP == CompareOp::GE) hit = col[i] >= value;
+        else hit = col[i] == value;
+        const int32_t m = hit ? -1 : 0;
+        mask[i] = first ? m : (mask[i] & m);
+    }
+#endif
+}
+
+void compare(const float* col, const Predicate& p, int32_t* mask, size_t padded, bool first) {
+    switch(p.op) {
+        case CompareOp::LT: compareKernel<CompareOp::LT>(col, p.value, mask, padded, first); break;
+        case CompareOp::LE: compareKernel<CompareOp::LE>(col, p.value, mask, padded, first); break;
+        case CompareOp::GT: compareKernel<CompareOp::GT>(col, p.value, mask, padded, first); break;
+        case CompareOp::GE: compareKernel<CompareOp::GE>(col, p.value, mask, padded, first); break;
+        case CompareOp::EQ: compareKernel<CompareOp::EQ>(col, p.value, mask, padded, first); break;
+    }
+}
+
+// Builds the selection mask for one chunk. Returns false if zone maps rule the
+// chunk out. Lanes past the chunk's last row are always cleared.
+bool filterChunk(const TelemetryTable::Chunk& chunk, const vector<Predicate>& where, int32_t* mask) {
+    const size_t rows = chunk.rows;
+    const size_t padded = (rows + LANES - 1) / LANES * LANES;
+
+    bool first = true;
+    for(const auto& p : where) {
+        const size_t c = static_cast<size_t>(p.column);
+        const ZoneVerdict verdict = classify(chunk.zones[c], p);
+        if(verdict == ZoneVerdict::NONE) return false;
+        if(verdict == ZoneVerdict::ALL) continue;
+        compare(chunk.columns[c], p, mask, padded, first);
+        first = false;
+    }
+    if(first) {
+        fill(mask, mask + rows, -1);
+    }
+    fill(mask + rows, mask + padded, 0);
+    return true;
+}
+
+struct GroupPartial {
+    uint64_t count;
+    double sum;
+    float min;
+    float max;
+};
+
+GroupPartial emptyPartial() {
+    return {0, 0.0, numeric_limits<float>::max(), numeric_limits<float>::lowest()};
+}
+
+void merge(GroupPartial& into, const GroupPartial& from) {
+    into.count += from.count;
+    into.sum += from.sum;
+    into.min = min(into.min, from.min);
+    into.max = max(into.max, from.max);
+}
+
+// Masked count/sum/min/max over one chunk column, vectorized.
+void aggregateChunk(const float* col, const int32_t* mask, size_t padded, GroupPartial& out) {
+#if defined(__GNUC__)
+    f32xN vsum = broadcast(0.0f);
+    f32xN vmin = broadcast(numeric_limits<float>::max());
+    f32xN vmax = broadcast(numeric_limits<float>::lowest());
+    i32xN vcount = {};
+    const f32xN zero = broadcast(0.0f);
+    const f32xN hi = broadcast(numeric_limits<float>::max());
+    const f32xN lo = broadcast(numeric_limits<float>::lowest());
+
+    for(size_t i = 0; i < padded; i += LANES) {
+        const f32xN x = load(col + i);
+        const i32xN m = loadMask(mask + i);
+        vsum += m ? x : zero;
+        const f32xN xmin = m ? x : hi;
+        const f32xN xmax = m ? x : lo;
+        vmin = xmin < vmin ? xmin : vmin;
+        vmax = xmax > vmax ? xmax : vmax;
+        vcount -= m; // lanes are -1 when selected
+    }
+
+    float sum = 0.0f;
+    for(size_t l = 0; l < LANES; l++) {
+        sum += vsum[l];
+        out.count += static_cast<uint64_t>(vcount[l]);
+        out.min = min(out.min, vmin[l]);
+        out.max = max(out.max, vmax[l]);
+    }
+    out.sum += sum;
+#else
+    for(size_t i = 0; i < padded; i++) {
+        if(!mask[i]) continue;
+        out.count++;
+        out.sum += col[i];
+        out.min = min(out.min, col[i]);
+        out.max = max(out.max, col[i]);
+    }
+#endif
+}
+
+// Dense group layout derived from the table's key ranges.
+struct GroupLayout {
+    GroupBy group_by;
+    uint32_t drivers;
+    uint32_t laps;
+    uint32_t sectors;
+
+    size_t size() const {
+        switch(group_by) {
+            case GroupBy::NONE: return 1;
+            case GroupBy::DRIVER: return drivers;
+            case GroupBy::LAP: return laps;
+            case GroupBy::SECTOR: return sectors;
+            case GroupBy::DRIVER_LAP: return static_cast<size_t>(drivers) * laps;
+            case GroupBy::DRIVER_SECTOR: return static_cast<size_t>(drivers) * sectors;
+        }
+        return 1;
+    }
+
+    // Every grouping is key = major * stride + minor over float columns, which
+    // hold small integers exactly; single-column groupings use stride 0.
+    void keyColumns(Column& major, Column& minor, float& stride) const {
+        major = minor = Column::DRIVER_ID;
+        stride = 0.0f;
+        switch(group_by) {
+            case GroupBy::NONE: break;
+            case GroupBy::DRIVER: break;
+            case GroupBy::LAP: major = minor = Column::LAP; break;
+            case GroupBy::SECTOR: major = minor = Column::SECTOR; break;
+            case GroupBy::DRIVER_LAP: minor = Column::LAP; stride = static_cast<float>(laps); break;
+            case GroupBy::DRIVER_SECTOR: minor = Column::SECTOR; stride = static_cast<float>(sectors); break;
+        }
+    }
+
+    // Group index of every row in the chunk, computed a vector at a time.
+    void keys(const TelemetryTable::Chunk& chunk, size_t padded, int32_t* out) const {
+        Column major, minor;
+        float stride;
+        keyColumns(major, minor, stride);
+        const float* a = chunk.columns[static_cast<size_t>(major)];
+        const float* b = chunk.columns[static_cast<size_t>(minor)];
+#if defined(__GNUC__)
+        const f32xN vstride = broadcast(stride);
+        for(size_t i = 0; i < padded; i += LANES) {
+            const f32xN k = (stride == 0.0f) ? load(b + i) : load(a + i) * vstride + load(b + i);
+            const i32xN ki = __builtin_convertvector(k, i32xN);
+            memcpy(out + i, &ki, sizeof(ki));
+        }
+#else
+        for(size_t i = 0; i < padded; i++) {
+            out[i] = static_cast<int32_t>(stride == 0.0f ? b[i] : a[i] * stride + b[i]);
+        }
+#endif
+    }
+
+    GroupResult decode(size_t g) const {
+        GroupResult r = {0, 0, 0, 0, 0.0};
+        switch(group_by) {
+            case GroupBy::NONE: break;
+            case GroupBy::DRIVER: r.driver_id = static_cast<uint32_t>(g); break;
+            case GroupBy::LAP: r.lap = static_cast<uint32_t>(g); break;
+            case GroupBy::SECTOR: r.sector = static_cast<uint32_t>(g); break;
+            case GroupBy::DRIVER_LAP:
+                r.driver_id = static_cast<uint32_t>(g / laps);
+                r.lap = static_cast<uint32_t>(g % laps);
+                break;
+            case GroupBy::DRIVER_SECTOR:
+                r.driver_id = static_cast<uint32_t>(g / sectors);
+                r.sector = static_cast<uint32_t>(g % sectors);
+                break;
+        }
+        return r;
+    }
+};
+
+// Scatters selected rows into their groups, doing only the work the aggregate
+// needs. Rows are spread over REPLICAS interleaved copies of the groups so that
+// consecutive rows landing in one group do not serialize on a single accumulator.
+constexpr size_t REPLICAS = 4;
+
+template<bool SUM, bool EXTREMA>
+void groupChunk(const float* values, const int32_t* keys, const int32_t* mask, size_t rows, GroupPartial* partials, size_t replica_stride) {
+    for(size_t row = 0; row < rows; row++) {
+        if(!mask[row]) continue;
+        auto& p = partials[(row % REPLICAS) * replica_stride + keys[row]];
+        const float v = values[row];
+        p.count++;
+        if constexpr (SUM) p.sum += v;
+        if constexpr (EXTREMA) {
+            p.min = min(p.min, v);
+            p.max = max(p.max, v);
+        }
+    }
+}
+
+uint32_t keyRange(const TelemetryTable& table, Column column) {
+    if(table.rowCount() == 0) return 1;
+    return static_cast<uint32_t>(max(0.0f, table.zone(column).max)) + 1;
+}
+
+} // namespace
+
+QueryEngine::QueryEngine(shared_ptr<ForkJoinPool> pool) : pool_(pool) {}
+
+size_t QueryEngine::taskCount(size_t chunks) const {
+    if(!pool_ || chunks == 0) return 1;
+    // A couple of tasks per thread evens out chunks that zone maps skip.
+    return min(chunks, pool_->parallelism() * 2);
+}
+
+QueryResult QueryEngine::run(const TelemetryTable& table, const Query& query) const {
+    GroupLayout layout = {query.group_by, 1, 1, 1};
+    if(query.group_by != GroupBy::NONE) {
+        layout.drivers = keyRange(table, Column::DRIVER_ID);
+        layout.laps = keyRange(table, Column::LAP);
+        layout.sectors = keyRange(table, Column::SECTOR);
+    }
+    const size_t groups = layout.size();
+    const size_t chunks = table.chunkCount();
+    const size_t tasks = taskCount(chunks);
+    const size_t column = static_cast<size_t>(query.column);
+    const size_t replicas = query.group_by == GroupBy::NONE ? 1 : REPLICAS;
+
+    struct TaskState {
+        vector<GroupPartial> partials;
+        uint64_t scanned = 0;
+        uint64_t skipped = 0;
+    };
+    vector<TaskState> states(tasks);
+
+    auto scan = [&](size_t task) {
+        auto& state = states[task];
+        state.partials.assign(groups * replicas, emptyPartial());
+        vector<int32_t> mask(CHUNK_ROWS);
+        vector<int32_t> keys(query.group_by == GroupBy::NONE ? 0 : CHUNK_ROWS);
+
+        const size_t begin = task * chunks / tasks;
+        const size_t end = (task + 1) * chunks / tasks;
+        for(size_t c = begin; c < end; c++) {
+            const auto& chunk = table.chunk(c);
+            if(!filterChunk(chunk, query.where, mask.data())) {
+                state.skipped++;
+                continue;
+            }
+            state.scanned++;
+
+            const size_t padded = (chunk.rows + LANES - 1) / LANES * LANES;
+            if(query.group_by == GroupBy::NONE) {
+                aggregateChunk(chunk.columns[column], mask.data(), padded, state.partials[0]);
+                continue;
+            }
+
+            // Keys are computed vectorized; the scatter itself is data-dependent and
+            // stays scalar over the rows the filter selected.
+            layout.keys(chunk, padded, keys.data());
+            const float* values = chunk.columns[column];
+            GroupPartial* partials = state.partials.data();
+            switch(query.aggregate) {
+                case Aggregate::COUNT: groupChunk<false, false>(values, keys.data(), mask.data(), chunk.rows, partials, groups); break;
+                case Aggregate::SUM:
+                case Aggregate::MEAN: groupChunk<true, false>(values, keys.data(), mask.data(), chunk.rows, partials, groups); break;
+                case Aggregate::MIN:
+                case Aggregate::MAX: groupChunk<false, true>(values, keys.data(), mask.data(), chunk.rows, partials, groups); break;
+            }
+        }
+
+        for(size_t r = 1; r < replicas; r++) {
+            for(size_t g = 0; g < groups; g++) {
+                merge(state.partials[g], state.partials[r * groups + g]);
+            }
+        }
+    };
+
+    if(pool_ && tasks > 1) {
+        pool_->run(tasks, scan);
+    } else {
+        for(size_t t = 0; t < tasks; t++) scan(t);
+    }
+
+    // Merge in task (chunk) order so results do not depend on scheduling.
+    vector<GroupPartial> totals(groups, emptyPartial());
+    QueryResult result = {{}, 0, 0, 0};
+    for(const auto& state : states) {
+        for(size_t g = 0; g < groups; g++) {
+            merge(totals[g], state.partials[g]);
+        }
+        result.chunks_scanned += state.scanned;
+        result.chunks_skipped += state.skipped;
+    }
+
+    for(size_t g = 0; g < groups; g++) {
+        const auto& p = totals[g];
+        result.rows_matched += p.count;
+        if(p.count == 0 && query.group_by != GroupBy::NONE) continue;
+
+        GroupResult r = layout.decode(g);
+        r.count = p.count;
+        switch(query.aggregate) {
+            case Aggregate::COUNT: r.value = static_cast<double>(p.count); break;
+            case Aggregate::SUM: r.value = p.sum; break;
+            case Aggregate::MIN: r.value = p.count ? p.min : 0.0; break;
+            case Aggregate::MAX: r.value = p.count ? p.max : 0.0; break;
+            case Aggregate::MEAN: r.value = p.count ? p.sum / static_cast<double>(p.count) : 0.0; break;
+        }
+        result.groups.push_back(r);
+    }
+    return result;
+}
+
+vector<uint64_t> QueryEngine::select(const TelemetryTable& table, const vector<Predicate>& where) const {
+    const size_t chunks = table.chunkCount();
+    const size_t tasks = taskCount(chunks);
+    vector<vector<uint64_t>> task_rows(tasks);
+
+    auto scan = [&](size_t task) {
+        vector<int32_t> mask(CHUNK_ROWS);
+        const size_t begin = task * chunks / tasks;
+        const size_t end = (task + 1) * chunks / tasks;
+        for(size_t c = begin; c < end; c++) {
+            const auto& chunk = table.chunk(c);
+            if(!filterChunk(chunk, where, mask.data())) continue;
+            for(size_t row = 0; row < chunk.rows; row++) {
+                if(mask[row]) task_rows[task].push_back(c * CHUNK_ROWS + row);
+            }
+        }
+    };
+
+    if(pool_ && tasks > 1) {
+        pool_->run(tasks, scan);
+    } else {
+        for(size_t t = 0; t < tasks; t++) scan(t);
+    }
+
+    vector<uint64_t> rows;
+    for(const auto& r : task_rows) {
+        rows.insert(rows.end(), r.begin(), r.end());
+    }
+    return rows;
+}
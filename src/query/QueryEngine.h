@@ -0,0 +1,81 @@
+#pragma once
+
+#include "TelemetryTable.h"
+#include "../common/ForkJoinPool.h"
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+enum class CompareOp : uint8_t {
+    LT,
+    LE,
+    GT,
+    GE,
+    EQ,
+};
+
+struct Predicate {
+    Column column;
+    CompareOp op;
+    float value;
+};
+
+enum class Aggregate : uint8_t {
+    COUNT,
+    SUM,
+    MIN,
+    MAX,
+    MEAN,
+};
+
+enum class GroupBy : uint8_t {
+    NONE,
+    DRIVER,
+    LAP,
+    SECTOR,
+    DRIVER_LAP,
+    DRIVER_SECTOR,
+};
+
+// SELECT aggregate(column) FROM table WHERE p1 AND p2 ... GROUP BY group_by
+struct Query {
+    std::vector<Predicate> where;
+    Aggregate aggregate;
+    Column column;
+    GroupBy group_by;
+};
+
+// Keys not covered by the grouping are 0.
+struct GroupResult {
+    uint32_t driver_id;
+    uint32_t lap;
+    uint32_t sector;
+    uint64_t count;
+    double value;
+};
+
+struct QueryResult {
+    std::vector<GroupResult> groups;  // non-empty groups in key order
+    uint64_t rows_matched;
+    uint64_t chunks_scanned;
+    uint64_t chunks_skipped;          // pruned by zone maps
+};
+
+// Scans TelemetryTable chunks with vectorized filter and aggregate kernels.
+// Chunks whose zone maps cannot match are skipped, and predicates a chunk's zone
+// map already guarantees are not evaluated. With a pool, chunk ranges are scanned
+// in parallel and merged in chunk order.
+class QueryEngine {
+public:
+    explicit QueryEngine(std::shared_ptr<ForkJoinPool> pool = nullptr);
+
+    QueryResult run(const TelemetryTable& table, const Query& query) const;
+
+    // Global row ids (chunk * CHUNK_ROWS + row) matching every predicate, ascending.
+    std::vector<uint64_t> select(const TelemetryTable& table, const std::vector<Predicate>& where) const;
+
+private:
+    std::shared_ptr<ForkJoinPool> pool_;
+
+    size_t taskCount(size_t chunks) const;
+};
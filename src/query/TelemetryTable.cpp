@@ -0,0 +1,81 @@
+#include "TelemetryTable.h"
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+void TelemetryTable::append(const TelemetryFrame& frame) {
+    if(chunks_.empty() || chunks_.back()->rows == CHUNK_ROWS) {
+        auto chunk = make_unique<Chunk>();
+        chunk->rows = 0;
+        for(auto& zone : chunk->zones) {
+            zone = {numeric_limits<float>::max(), numeric_limits<float>::lowest()};
+        }
+        chunks_.push_back(std::move(chunk));
+    }
+
+    Chunk& chunk = *chunks_.back();
+    const size_t row = chunk.rows++;
+
+    const float values[COLUMN_COUNT] = {
+        static_cast<float>(frame.driver_id),
+        static_cast<float>(frame.lap),
+        static_cast<float>(frame.sector),
+        static_cast<float>(frame.car_class),
+        static_cast<float>(frame.race_position),
+        frame.speed_kph,
+        frame.throttle,
+        frame.brake,
+        frame.tire_temp_c[0],
+        frame.tire_temp_c[1],
+        frame.tire_temp_c[2],
+        frame.tire_temp_c[3],
+        frame.tire_wear,
+    };
+    for(size_t c = 0; c < COLUMN_COUNT; c++) {
+        chunk.columns[c][row] = values[c];
+        chunk.zones[c].min = min(chunk.zones[c].min, values[c]);
+        chunk.zones[c].max = max(chunk.zones[c].max, values[c]);
+    }
+    chunk.timestamp_ns[row] = frame.timestamp_ns;
+}
+
+void TelemetryTable::append(span<const TelemetryFrame> frames) {
+    for(const auto& frame : frames) {
+        append(frame);
+    }
+}
+
+size_t TelemetryTable::rowCount() const {
+    if(chunks_.empty()) return 0;
+    return (chunks_.size() - 1) * CHUNK_ROWS + chunks_.back()->rows;
+}
+
+TelemetryTable::ZoneMap TelemetryTable::zone(Column column) const {
+    ZoneMap result = {numeric_limits<float>::max(), numeric_limits<float>::lowest()};
+    const size_t c = static_cast<size_t>(column);
+    for(const auto& chunk : chunks_) {
+        result.min = min(result.min, chunk->zones[c].min);
+        result.max = max(result.max, chunk->zones[c].max);
+    }
+    return result;
+}
+
+const char* TelemetryTable::columnName(Column column) {
+    switch(column) {
+        case Column::DRIVER_ID: return "driver_id";
+        case Column::LAP: return "lap";
+        case Column::SECTOR: return "sector";
+        case Column::CAR_CLASS: return "car_class";
+        case Column::RACE_POSITION: return "race_position";
+        case Column::SPEED: return "speed_kph";
+        case Column::THROTTLE: return "throttle";
+        case Column::BRAKE: return "brake";
+        case Column::TIRE_TEMP_FL: return "tire_temp_fl";
+        case Column::TIRE_TEMP_FR: return "tire_temp_fr";
+        case Column::TIRE_TEMP_RL: return "tire_temp_rl";
+        case Column::TIRE_TEMP_RR: return "tire_temp_rr";
+        case Column::TIRE_WEAR: return "tire_wear";
+    }
+    return "unknown";
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "../common/types.h"
+#include <array>
+#include <memory>
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Queryable TelemetryFrame channels. Every column is stored as float32 (ids, laps
+// and positions are exact well past any real race) so one set of kernels serves all.
+enum class Column : uint8_t {
+    DRIVER_ID,
+    LAP,
+    SECTOR,
+    CAR_CLASS,
+    RACE_POSITION,
+    SPEED,
+    THROTTLE,
+    BRAKE,
+    TIRE_TEMP_FL,
+    TIRE_TEMP_FR,
+    TIRE_TEMP_RL,
+    TIRE_TEMP_RR,
+    TIRE_WEAR,
+};
+
+constexpr size_t COLUMN_COUNT = 13;
+
+// Append-only columnar store of recorded frames, split into fixed-size chunks.
+// Each chunk keeps a min/max zone map per column so scans can skip it outright.
+class TelemetryTable {
+public:
+    static constexpr size_t CHUNK_ROWS = 4096;
+
+    struct ZoneMap {
+        float min;
+        float max;
+    };
+
+    struct Chunk {
+        size_t rows;
+        std::array<ZoneMap, COLUMN_COUNT> zones;
+        alignas(32) float columns[COLUMN_COUNT][CHUNK_ROWS];
+        uint64_t timestamp_ns[CHUNK_ROWS];
+    };
+
+    TelemetryTable() = default;
+
+    void append(const TelemetryFrame& frame);
+    void append(std::span<const TelemetryFrame> frames);
+
+    size_t rowCount() const;
+    size_t chunkCount() const { return chunks_.size(); }
+    const Chunk& chunk(size_t index) const { return *chunks_[index]; }
+
+    // Table-wide zone map (the union of every chunk's).
+    ZoneMap zone(Column column) const;
+
+    static const char* columnName(Column column);
+
+private:
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+};
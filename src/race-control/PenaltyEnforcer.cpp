@@ -1,9 +1,10 @@
 #include "PenaltyEnforcer.h"
+#include "../monitoring/MetricsRegistry.h"
 
 using namespace std;
 
-PenaltyEnforcer::PenaltyEnforcer(const std::vector<DriverProfile>& drivers) {
-    for(uint32_t i = 0; i < drivers.size(); i++) {
+PenaltyEnforcer::PenaltyEnforcer(size_t entry_count) {
+    for(uint32_t i = 0; i < entry_count; i++) {
         penalties_.insert({i, {PenaltyState::NONE, 0, 0ULL, 0ULL}});
     }
 }
@@ -16,6 +17,8 @@ void PenaltyEnforcer::issuePenalty(uint32_t driver_id, uint32_t seconds) {
     info.penalty_seconds = seconds;
     info.penalty_duration_ns = static_cast<uint64_t>(seconds) * 1'000'000'000ULL;
     info.penalty_start_time_ns = 0ULL;
+
+    Metrics::increment(Counter::PENALTIES_ISSUED);
 }
 
 bool PenaltyEnforcer::shouldServePenalty(uint32_t driver_id, uint64_t current_time_ns) {
@@ -53,4 +56,21 @@ bool PenaltyEnforcer::isPenaltyComplete(uint32_t driver_id, uint64_t current_tim
 DriverPenaltyInfo PenaltyEnforcer::getPenaltyInfo(uint32_t driver_id) const {
     lock_guard<mutex> lock(mutex_);
     return penalties_.at(driver_id);
-}
\ No newline at end of file
+}
+
+map<uint32_t, DriverPenaltyInfo> PenaltyEnforcer::snapshot() const {
+    lock_guard<mutex> lock(mutex_);
+    return penalties_;
+}
+
+void PenaltyEnforcer::restore(const map<uint32_t, DriverPenaltyInfo>& penalties) {
+    lock_guard<mutex> lock(mutex_);
+    penalties_ = penalties;
+}
+
+void PenaltyEnforcer::reset() {
+    lock_guard<mutex> lock(mutex_);
+    for(auto& [driver_id, info] : penalties_) {
+        info = {PenaltyState::NONE, 0, 0ULL, 0ULL};
+    }
+}
@@ -2,6 +2,7 @@
 
 #include "../common/types.h"
 #include <map>
+#include <vector>
 #include <cstdint>
 #include <mutex>
 
@@ -22,12 +23,19 @@ struct DriverPenaltyInfo {
 
 class PenaltyEnforcer {
 public:
-    PenaltyEnforcer(const std::vector<DriverProfile>& drivers);
+    // One slot per grid entry (frame driver id).
+    explicit PenaltyEnforcer(size_t entry_count);
 
     void issuePenalty(uint32_t driver_id, uint32_t seconds);
     bool shouldServePenalty(uint32_t driver_id, uint64_t current_time_ns);
     bool isPenaltyComplete(uint32_t driver_id, uint64_t current_time_ns);
     DriverPenaltyInfo getPenaltyInfo(uint32_t driver_id) const;
+
+    // Full penalty table, for race checkpoints.
+    std::map<uint32_t, DriverPenaltyInfo> snapshot() const;
+    void restore(const std::map<uint32_t, DriverPenaltyInfo>& penalties);
+    // Clears every entry back to NONE in place, for reuse across races.
+    void reset();
     
 private:
     std::map<uint32_t, DriverPenaltyInfo> penalties_;
@@ -1,48 +1,71 @@
 #include "TrackLimitsMonitor.h"
 #include <random>
 #include <mutex>
+#include <sstream>
+#include <algorithm>
 
 using namespace std;
 
-static std::random_device rd;
-static std::mt19937 gen(rd());
-std::uniform_real_distribution<float> dis(0.0f, 1.0f);
-
 TrackLimitsMonitor::TrackLimitsMonitor(
     const TrackProfile &track,
-    const vector<DriverProfile> &drivers,
+    shared_ptr<const ProfileTable> profiles,
     std::shared_ptr<PenaltyEnforcer> penalty_enforcer
-) : track_(track), drivers_(drivers), penalty_enforcer_(penalty_enforcer) {
-    for(uint32_t i = 0; i < drivers.size(); i++) {
-        driver_violations_.insert({i, TrackLimitsState{0, false, {}}});
+) : TrackLimitsMonitor(track, std::move(profiles), penalty_enforcer, random_device{}()) {}
+
+TrackLimitsMonitor::TrackLimitsMonitor(
+    const TrackProfile &track,
+    shared_ptr<const ProfileTable> profiles,
+    std::shared_ptr<PenaltyEnforcer> penalty_enforcer,
+    uint32_t seed
+) : TrackLimitsMonitor(track, profiles, profiles->defaultGrid(), std::move(penalty_enforcer), seed) {}
+
+TrackLimitsMonitor::TrackLimitsMonitor(
+    const TrackProfile &track,
+    shared_ptr<const ProfileTable> profiles,
+    const vector<GridEntry> &grid,
+    std::shared_ptr<PenaltyEnforcer> penalty_enforcer,
+    uint32_t seed
+) : track_(track), profiles_(std::move(profiles)), grid_(grid), penalty_enforcer_(penalty_enforcer),
+    gen_(seed), dis_(0.0f, 1.0f), last_sector_(grid_.size(), 0) {
+    for(uint32_t i = 0; i < grid_.size(); i++) {
+        auto &state = driver_violations_.insert({i, TrackLimitsState{0, false, {}}}).first->second;
+        // A race rarely sees more than a handful of violations per driver.
+        state.violation_laps.reserve(8);
     }
 }
 
 void TrackLimitsMonitor::processFrame(const TelemetryFrame &frame) {
     // Only check for violations at sector boundaries (not every frame)
-    static std::map<uint32_t, uint8_t> last_sector;
-    
-    if (last_sector[frame.driver_id] != frame.sector) {
-        last_sector[frame.driver_id] = frame.sector;
-        
-        const auto &driver = drivers_[frame.driver_id];
-        float aggression_factor = driver.aggression * 0.01f;
-        float speed_factor = (frame.speed_kph > 200.0f) ? 0.005f : 0.0f;
-        float tire_wear_factor = (frame.tire_wear > 0.6f) ? frame.tire_wear * 0.01f : 0.0f;
-        float violation_probability = aggression_factor + speed_factor + tire_wear_factor;
-
-        if(dis(gen) < violation_probability) {
-            unique_lock<mutex> lock(mutex_);
-            auto &state = driver_violations_[frame.driver_id];
-            state.warnings += 1;
-            state.violation_laps.push_back(frame.lap);
-
-            if(state.warnings == 3 && !state.has_penalty) {
-                state.has_penalty = true;
-                penalty_enforcer_->issuePenalty(frame.driver_id, 5);
-            }
-
-            lock.unlock();
+    if (last_sector_[frame.driver_id] != frame.sector) {
+        last_sector_[frame.driver_id] = frame.sector;
+        checkSector(frame.driver_id, frame.lap, frame.speed_kph, frame.tire_wear);
+    }
+}
+
+void TrackLimitsMonitor::processSectorEvent(const SectorEvent &event) {
+    // The event already marks a boundary; keep last_sector_ in step for snapshots.
+    last_sector_[event.driver_id] = event.sector;
+    checkSector(event.driver_id, event.lap, event.speed_kph, event.tire_wear);
+}
+
+void TrackLimitsMonitor::checkSector(uint32_t driver_id, uint32_t lap, float speed_kph, float tire_wear) {
+    const auto &driver = profiles_->drivers()[grid_[driver_id].driver_index];
+    float aggression_factor = driver.aggression * 0.01f;
+    float speed_factor = (speed_kph > 200.0f) ? 0.005f : 0.0f;
+    float tire_wear_factor = (tire_wear > 0.6f) ? tire_wear * 0.01f : 0.0f;
+    float violation_probability = aggression_factor + speed_factor + tire_wear_factor;
+
+    // Different drivers may be checked from different threads, and they share the
+    // RNG, so the draw is made under the lock as well.
+    lock_guard<mutex> lock(mutex_);
+    if(dis_(gen_) < violation_probability) {
+        auto &state = driver_violations_[driver_id];
+        state.warnings += 1;
+        state.violation_laps.push_back(lap);
+
+        if(state.warnings == 3 && !state.has_penalty) {
+            state.has_penalty = true;
+            penalty_enforcer_->issuePenalty(driver_id, 5);
         }
     }
 }
@@ -51,3 +74,42 @@ TrackLimitsState TrackLimitsMonitor::getDriverState(uint32_t driver_id) const {
     lock_guard<mutex> lock(mutex_);
     return driver_violations_.at(driver_id);
 }
+
+uint32_t TrackLimitsMonitor::getWarnings(uint32_t driver_id) const {
+    lock_guard<mutex> lock(mutex_);
+    return driver_violations_.at(driver_id).warnings;
+}
+
+TrackLimitsSnapshot TrackLimitsMonitor::snapshot() const {
+    lock_guard<mutex> lock(mutex_);
+    ostringstream rng;
+    rng << gen_;
+    return TrackLimitsSnapshot{driver_violations_, last_sector_, rng.str()};
+}
+
+bool TrackLimitsMonitor::restore(const TrackLimitsSnapshot& snapshot) {
+    if(snapshot.last_sector.size() != last_sector_.size()) return false;
+
+    istringstream rng(snapshot.rng_state);
+    mt19937 gen;
+    if(!(rng >> gen)) return false;
+
+    lock_guard<mutex> lock(mutex_);
+    driver_violations_ = snapshot.violations;
+    last_sector_ = snapshot.last_sector;
+    gen_ = gen;
+    dis_.reset();
+    return true;
+}
+
+void TrackLimitsMonitor::reset(uint32_t seed) {
+    lock_guard<mutex> lock(mutex_);
+    for(auto& [driver_id, state] : driver_violations_) {
+        state.warnings = 0;
+        state.has_penalty = false;
+        state.violation_laps.clear();
+    }
+    fill(last_sector_.begin(), last_sector_.end(), 0);
+    gen_.seed(seed);
+    dis_.reset();
+}
@@ -3,8 +3,12 @@
 #include "../common/types.h"
 #include <vector>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <random>
+#include <string>
 #include "PenaltyEnforcer.h"
+#include "../data/ProfileTable.h"
 
 struct TrackLimitsState {
     uint32_t warnings;
@@ -12,19 +16,52 @@ struct TrackLimitsState {
     std::vector<uint32_t> violation_laps;
 };
 
+// Everything processFrame() depends on, including the violation RNG, so a
+// restored monitor draws the same violations as the original would have.
+struct TrackLimitsSnapshot {
+    std::map<uint32_t, TrackLimitsState> violations;
+    std::vector<uint8_t> last_sector;
+    std::string rng_state;
+};
+
+// Driver ids in frames and events are grid slots; traits come from each slot's
+// driver profile.
 class TrackLimitsMonitor{
 public:
-    TrackLimitsMonitor(const TrackProfile& track, const std::vector<DriverProfile>& drivers, std::shared_ptr<PenaltyEnforcer> penalty_enforcer);
+    TrackLimitsMonitor(const TrackProfile& track, std::shared_ptr<const ProfileTable> profiles, std::shared_ptr<PenaltyEnforcer> penalty_enforcer);
+    // Seeded variant for reproducible headless runs (batch sweeps, replays).
+    TrackLimitsMonitor(const TrackProfile& track, std::shared_ptr<const ProfileTable> profiles, std::shared_ptr<PenaltyEnforcer> penalty_enforcer, uint32_t seed);
+    // Explicit grid, as given to the TelemetryGenerator; the others use the season grid.
+    TrackLimitsMonitor(const TrackProfile& track, std::shared_ptr<const ProfileTable> profiles, const std::vector<GridEntry>& grid, std::shared_ptr<PenaltyEnforcer> penalty_enforcer, uint32_t seed);
 
+    // Safe to call from several threads as long as each driver's frames come from
+    // one thread at a time.
     void processFrame(const TelemetryFrame& frame);
+    // Same check, fed from the SECTOR stream tier instead of every frame.
+    void processSectorEvent(const SectorEvent& event);
 
     TrackLimitsState getDriverState(uint32_t driver_id) const;
+    // Allocation-free alternative to getDriverState() for per-refresh display.
+    uint32_t getWarnings(uint32_t driver_id) const;
+
+    TrackLimitsSnapshot snapshot() const;
+    bool restore(const TrackLimitsSnapshot& snapshot);
+    // Back to a fresh monitor with `seed`, keeping its storage (batch sweeps).
+    void reset(uint32_t seed);
 
 private:
     TrackProfile track_;
-    std::vector<DriverProfile> drivers_;
+    std::shared_ptr<const ProfileTable> profiles_;
+    std::vector<GridEntry> grid_;
     std::shared_ptr<PenaltyEnforcer> penalty_enforcer_;
 
     std::map<uint32_t, TrackLimitsState> driver_violations_;
+
+    // Per-instance so independent races can run on different threads.
+    std::mt19937 gen_;
+    std::uniform_real_distribution<float> dis_;
+    std::vector<uint8_t> last_sector_;
     mutable std::mutex mutex_;
+
+    void checkSector(uint32_t driver_id, uint32_t lap, float speed_kph, float tire_wear);
 };
\ No newline at end of file
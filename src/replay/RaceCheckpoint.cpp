@@ -0,0 +1,194 @@
+#include "RaceCheckpoint.h"
+#include <fstream>
+#include <cstring>
+#include <type_traits>
+
+using namespace std;
+
+namespace {
+
+constexpr char MAGIC[8] = "F1CKPT";   // 6 chars + NUL, padded to 8
+constexpr uint32_t FORMAT_VERSION = 1;
+
+// Fields are written one by one (never whole structs) so the file layout does
+// not depend on struct padding.
+template<typename T>
+void put(ofstream& out, T value) {
+    static_assert(is_arithmetic_v<T>, "put() takes scalars");
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename T>
+bool get(ifstream& in, T& value) {
+    static_assert(is_arithmetic_v<T>, "get() takes scalars");
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+void putTrack(ofstream& out, const TrackProfile& t) {
+    put(out, t.track_id);
+    put(out, t.sectors);
+    put(out, t.lap_length_km);
+    put(out, t.tire_wear_factor);
+    put(out, t.overtaking_difficulty);
+    put(out, t.safety_car_probability);
+}
+
+bool getTrack(ifstream& in, TrackProfile& t) {
+    return get(in, t.track_id) && get(in, t.sectors) && get(in, t.lap_length_km)
+        && get(in, t.tire_wear_factor) && get(in, t.overtaking_difficulty) && get(in, t.safety_car_probability);
+}
+
+void putState(ofstream& out, const DriverState& s) {
+    put(out, s.lap);
+    put(out, s.sector);
+    put(out, s.tire_wear);
+    put(out, s.distance_in_lap);
+    for(float t : s.tire_temp_c) put(out, t);
+    put(out, static_cast<uint8_t>(s.is_on_pit));
+    put(out, static_cast<uint8_t>(s.has_pitted));
+    put(out, s.pit_stop_start_time_ns);
+    put(out, s.pit_stop_end_time_ns);
+}
+
+bool getState(ifstream& in, DriverState& s) {
+    uint8_t on_pit = 0;
+    uint8_t pitted = 0;
+    bool ok = get(in, s.lap) && get(in, s.sector) && get(in, s.tire_wear) && get(in, s.distance_in_lap);
+    for(float& t : s.tire_temp_c) ok = ok && get(in, t);
+    ok = ok && get(in, on_pit) && get(in, pitted) && get(in, s.pit_stop_start_time_ns) && get(in, s.pit_stop_end_time_ns);
+    s.is_on_pit = on_pit != 0;
+    s.has_pitted = pitted != 0;
+    return ok;
+}
+
+void putPenalty(ofstream& out, const DriverPenaltyInfo& p) {
+    put(out, static_cast<uint8_t>(p.state));
+    put(out, p.penalty_seconds);
+    put(out, p.penalty_start_time_ns);
+    put(out, p.penalty_duration_ns);
+}
+
+bool getPenalty(ifstream& in, DriverPenaltyInfo& p) {
+    uint8_t state = 0;
+    const bool ok = get(in, state) && get(in, p.penalty_seconds) && get(in, p.penalty_start_time_ns) && get(in, p.penalty_duration_ns);
+    p.state = static_cast<PenaltyState>(state);
+    return ok;
+}
+
+void putLimits(ofstream& out, const TrackLimitsState& s) {
+    put(out, s.warnings);
+    put(out, static_cast<uint8_t>(s.has_penalty));
+    put(out, static_cast<uint32_t>(s.violation_laps.size()));
+    for(uint32_t lap : s.violation_laps) put(out, lap);
+}
+
+bool getLimits(ifstream& in, TrackLimitsState& s) {
+    uint8_t has_penalty = 0;
+    uint32_t count = 0;
+    if(!(get(in, s.warnings) && get(in, has_penalty) && get(in, count))) return false;
+    s.has_penalty = has_penalty != 0;
+    s.violation_laps.resize(count);
+    for(uint32_t& lap : s.violation_laps) {
+        if(!get(in, lap)) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool RaceCheckpoint::write(const string& path) const {
+    ofstream out(path, ios::binary | ios::trunc);
+    if(!out) return false;
+
+    out.write(MAGIC, sizeof(MAGIC));
+    put(out, FORMAT_VERSION);
+
+    putTrack(out, track);
+    put(out, total_laps);
+    put(out, seed);
+    put(out, driver_count);
+    put(out, tick);
+    put(out, leader_lap);
+
+    put(out, generator.current_time_ns);
+    put(out, static_cast<uint32_t>(generator.states.size()));
+    for(const auto& s : generator.states) putState(out, s);
+    put(out, static_cast<uint32_t>(generator.optimal_strategies.size()));
+    for(const auto& [driver, lap] : generator.optimal_strategies) {
+        put(out, driver);
+        put(out, lap);
+    }
+
+    put(out, static_cast<uint32_t>(penalties.size()));
+    for(const auto& [driver, info] : penalties) {
+        put(out, driver);
+        putPenalty(out, info);
+    }
+
+    put(out, static_cast<uint32_t>(track_limits.violations.size()));
+    for(const auto& [driver, state] : track_limits.violations) {
+        put(out, driver);
+        putLimits(out, state);
+    }
+    put(out, static_cast<uint32_t>(track_limits.last_sector.size()));
+    out.write(reinterpret_cast<const char*>(track_limits.last_sector.data()), track_limits.last_sector.size());
+    put(out, static_cast<uint32_t>(track_limits.rng_state.size()));
+    out.write(track_limits.rng_state.data(), track_limits.rng_state.size());
+
+    return static_cast<bool>(out);
+}
+
+bool RaceCheckpoint::read(const string& path, RaceCheckpoint& out) {
+    ifstream in(path, ios::binary);
+    if(!in) return false;
+
+    char magic[sizeof(MAGIC)];
+    uint32_t version = 0;
+    if(!in.read(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) return false;
+    if(!get(in, version) || version != FORMAT_VERSION) return false;
+
+    RaceCheckpoint c;
+    if(!(getTrack(in, c.track) && get(in, c.total_laps) && get(in, c.seed) && get(in, c.driver_count)
+         && get(in, c.tick) && get(in, c.leader_lap))) {
+        return false;
+    }
+
+    uint32_t count = 0;
+    if(!(get(in, c.generator.current_time_ns) && get(in, count))) return false;
+    c.generator.states.resize(count);
+    for(auto& s : c.generator.states) {
+        if(!getState(in, s)) return false;
+    }
+    if(!get(in, count)) return false;
+    for(uint32_t i = 0; i < count; i++) {
+        uint32_t driver = 0;
+        uint32_t lap = 0;
+        if(!(get(in, driver) && get(in, lap))) return false;
+        c.generator.optimal_strategies[driver] = lap;
+    }
+
+    if(!get(in, count)) return false;
+    for(uint32_t i = 0; i < count; i++) {
+        uint32_t driver = 0;
+        DriverPenaltyInfo info;
+        if(!(get(in, driver) && getPenalty(in, info))) return false;
+        c.penalties[driver] = info;
+    }
+
+    if(!get(in, count)) return false;
+    for(uint32_t i = 0; i < count; i++) {
+        uint32_t driver = 0;
+        TrackLimitsState state;
+        if(!(get(in, driver) && getLimits(in, state))) return false;
+        c.track_limits.violations[driver] = std::move(state);
+    }
+    if(!get(in, count)) return false;
+    c.track_limits.last_sector.resize(count);
+    if(!in.read(reinterpret_cast<char*>(c.track_limits.last_sector.data()), count)) return false;
+    if(!get(in, count)) return false;
+    c.track_limits.rng_state.resize(count);
+    if(!in.read(c.track_limits.rng_state.data(), count)) return false;
+
+    out = std::move(c);
+    return true;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "../common/types.h"
+#include "../telemetry/TelemetryGenerator.h"
+#include "../race-control/PenaltyEnforcer.h"
+#include "../race-control/TrackLimitsMonitor.h"
+#include <map>
+#include <string>
+#include <cstdint>
+
+// Complete race state at a tick boundary: enough to resume a race, or branch
+// several independent continuations from it, with bit-identical results.
+struct RaceCheckpoint {
+    // Race configuration. Driver and car profiles are not stored; the restoring
+    // side supplies them and only the grid size is checked.
+    TrackProfile track;
+    uint32_t total_laps;
+    uint32_t seed;
+    uint32_t driver_count;
+
+    uint64_t tick;
+    uint32_t leader_lap;
+
+    GeneratorSnapshot generator;
+    std::map<uint32_t, DriverPenaltyInfo> penalties;
+    TrackLimitsSnapshot track_limits;
+
+    // Binary file, "F1CKPT" magic plus a format version; false on I/O or format errors.
+    bool write(const std::string& path) const;
+    static bool read(const std::string& path, RaceCheckpoint& out);
+};
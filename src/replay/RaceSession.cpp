@@ -0,0 +1,109 @@
+#include "RaceSession.h"
+#include <algorithm>
+
+using namespace std;
+
+RaceSession::RaceSession(
+    const TrackProfile& track,
+    shared_ptr<const ProfileTable> profiles,
+    uint32_t total_laps,
+    uint32_t seed
+) : track_(track), total_laps_(total_laps), seed_(seed),
+    penalty_enforcer_(make_shared<PenaltyEnforcer>(profiles->drivers().size())),
+    generator_(track, profiles, total_laps, penalty_enforcer_),
+    track_limits_(track, profiles, penalty_enforcer_, seed),
+    frames_(profiles->drivers().size(), TelemetryFrame{}),
+    tick_(0), leader_lap_(0), finished_(false), checkpoint_every_(0) {}
+
+bool RaceSession::step() {
+    if(finished_) return false;
+
+    // Same order as the live producer/consumer: generate, check finish, then process.
+    generator_.next(frames_);
+    if(generator_.isRaceFinished()) {
+        finished_ = true;
+        return false;
+    }
+
+    uint32_t leader_lap = 0;
+    for(const auto& frame : frames_) {
+        track_limits_.processFrame(frame);
+        leader_lap = max(leader_lap, frame.lap);
+    }
+    tick_++;
+
+    const bool new_lap = leader_lap > leader_lap_;
+    leader_lap_ = leader_lap;
+    if(new_lap && checkpoint_every_ != 0 && leader_lap_ % checkpoint_every_ == 0) {
+        checkpoint_sink_(checkpoint());
+    }
+    return true;
+}
+
+void RaceSession::run() {
+    while(step()) {}
+}
+
+span<const TelemetryFrame> RaceSession::frames() const {
+    return frames_;
+}
+
+bool RaceSession::finished() const {
+    return finished_;
+}
+
+uint64_t RaceSession::tick() const {
+    return tick_;
+}
+
+uint32_t RaceSession::leaderLap() const {
+    return leader_lap_;
+}
+
+RaceCheckpoint RaceSession::checkpoint() const {
+    RaceCheckpoint c;
+    c.track = track_;
+    c.total_laps = total_laps_;
+    c.seed = seed_;
+    c.driver_count = static_cast<uint32_t>(frames_.size());
+    c.tick = tick_;
+    c.leader_lap = leader_lap_;
+    c.generator = generator_.snapshot();
+    c.penalties = penalty_enforcer_->snapshot();
+    c.track_limits = track_limits_.snapshot();
+    return c;
+}
+
+bool RaceSession::restore(const RaceCheckpoint& checkpoint) {
+    if(checkpoint.track.track_id != track_.track_id || checkpoint.total_laps != total_laps_) return false;
+    if(checkpoint.driver_count != frames_.size() || checkpoint.generator.states.size() != frames_.size()) return false;
+    if(checkpoint.track_limits.last_sector.size() != frames_.size()) return false;
+
+    // Sizes are checked above, so neither restore can fail half-way through.
+    if(!track_limits_.restore(checkpoint.track_limits)) return false;
+    generator_.restore(checkpoint.generator);
+    penalty_enforcer_->restore(checkpoint.penalties);
+
+    seed_ = checkpoint.seed;
+    tick_ = checkpoint.tick;
+    leader_lap_ = checkpoint.leader_lap;
+    finished_ = false;
+    return true;
+}
+
+void RaceSession::setCheckpointInterval(uint32_t every_laps, function<void(const RaceCheckpoint&)> sink) {
+    checkpoint_every_ = sink ? every_laps : 0;
+    checkpoint_sink_ = std::move(sink);
+}
+
+TelemetryGenerator& RaceSession::generator() {
+    return generator_;
+}
+
+PenaltyEnforcer& RaceSession::penalties() {
+    return *penalty_enforcer_;
+}
+
+TrackLimitsMonitor& RaceSession::trackLimits() {
+    return track_limits_;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "RaceCheckpoint.h"
+#include "../common/types.h"
+#include "../telemetry/TelemetryGenerator.h"
+#include "../race-control/PenaltyEnforcer.h"
+#include "../race-control/TrackLimitsMonitor.h"
+#include <vector>
+#include <memory>
+#include <functional>
+#include <span>
+#include <cstdint>
+
+// A headless race: generator, penalty enforcer and track-limits monitor stepped
+// in lockstep, with the same tick order as the live pipeline. The whole state
+// can be checkpointed at any tick boundary and restored into a fresh session to
+// resume the race, or into several sessions to branch it.
+class RaceSession {
+public:
+    RaceSession(const TrackProfile& track, std::shared_ptr<const ProfileTable> profiles, uint32_t total_laps, uint32_t seed);
+
+    // Advances one tick. Returns false once the race is finished; the frames of
+    // the finishing tick are still available from frames().
+    bool step();
+    // Steps until the race finishes.
+    void run();
+
+    std::span<const TelemetryFrame> frames() const;
+    bool finished() const;
+    uint64_t tick() const;
+    uint32_t leaderLap() const;
+
+    RaceCheckpoint checkpoint() const;
+    // Fails (and leaves the session untouched) if the checkpoint is for a different
+    // track, race length or grid size. The seed is taken from the checkpoint.
+    bool restore(const RaceCheckpoint& checkpoint);
+
+    // Calls `sink` with a checkpoint each time the leader starts a lap that is a
+    // multiple of `every_laps`. 0 disables it.
+    void setCheckpointInterval(uint32_t every_laps, std::function<void(const RaceCheckpoint&)> sink);
+
+    TelemetryGenerator& generator();
+    PenaltyEnforcer& penalties();
+    TrackLimitsMonitor& trackLimits();
+
+private:
+    TrackProfile track_;
+    uint32_t total_laps_;
+    uint32_t seed_;
+
+    std::shared_ptr<PenaltyEnforcer> penalty_enforcer_;
+    TelemetryGenerator generator_;
+    TrackLimitsMonitor track_limits_;
+
+    std::vector<TelemetryFrame> frames_;
+    uint64_t tick_;
+    uint32_t leader_lap_;
+    bool finished_;
+
+    uint32_t checkpoint_every_;
+    std::function<void(const RaceCheckpoint&)> checkpoint_sink_;
+};
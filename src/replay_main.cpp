@@ -0,0 +1,178 @@
+#include "replay/RaceSession.h"
+#include "replay/RaceCheckpoint.h"
+#include "data/season_data.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <filesystem>
+#include <algorithm>
+
+using namespace std;
+
+void printUsage(){
+    cout << "Usage: f1-replay [options]\n"
+         << "  --profiles PATH       season profile file (default: built-in 2025 season)\n"
+         << "  --track N             track id from the season track library (default: 1)\n"
+         << "  --laps N              race length (default: 52)\n"
+         << "  --seed N              track-limits seed (default: 1)\n"
+         << "  --checkpoint-every N  write a checkpoint every N leader laps (default: off)\n"
+         << "  --checkpoint-dir DIR  where checkpoints are written (default: .)\n"
+         << "  --resume PATH         continue the race from a checkpoint instead of the start\n"
+         << "  --pit DRIVER:LAP      what-if: plan a pit stop for a driver index, applied\n"
+         << "                        after the start or resume point (repeatable)\n";
+}
+
+// FNV-1a over the simulation state; equal digests mean identical races.
+uint64_t stateDigest(const RaceCheckpoint& c){
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for(size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+
+    mix(&c.tick, sizeof(c.tick));
+    mix(&c.generator.current_time_ns, sizeof(c.generator.current_time_ns));
+    for(const auto& s : c.generator.states) {
+        mix(&s.lap, sizeof(s.lap));
+        mix(&s.distance_in_lap, sizeof(s.distance_in_lap));
+        mix(&s.tire_wear, sizeof(s.tire_wear));
+        mix(s.tire_temp_c, sizeof(s.tire_temp_c));
+        mix(&s.pit_stop_end_time_ns, sizeof(s.pit_stop_end_time_ns));
+    }
+    for(const auto& [driver, info] : c.penalties) {
+        mix(&info.state, sizeof(info.state));
+        mix(&info.penalty_start_time_ns, sizeof(info.penalty_start_time_ns));
+    }
+    for(const auto& [driver, state] : c.track_limits.violations) {
+        mix(&state.warnings, sizeof(state.warnings));
+    }
+    return hash;
+}
+
+int main(int argc, char** argv){
+    uint32_t track_id = 1;
+    uint32_t laps = 52;
+    uint32_t seed = 1;
+    uint32_t checkpoint_every = 0;
+    string checkpoint_dir = ".";
+    string resume_path;
+    string profiles_path;
+    map<uint32_t, uint32_t> pit_overrides;
+
+    for(int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const bool has_value = (i + 1 < argc);
+
+        if(strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            printUsage();
+            return 0;
+        } else if(strcmp(arg, "--profiles") == 0 && has_value) {
+            profiles_path = argv[++i];
+        } else if(strcmp(arg, "--track") == 0 && has_value) {
+            track_id = static_cast<uint32_t>(stoul(argv[++i]));
+        } else if(strcmp(arg, "--laps") == 0 && has_value) {
+            laps = static_cast<uint32_t>(stoul(argv[++i]));
+        } else if(strcmp(arg, "--seed") == 0 && has_value) {
+            seed = static_cast<uint32_t>(stoul(argv[++i]));
+        } else if(strcmp(arg, "--checkpoint-every") == 0 && has_value) {
+            checkpoint_every = static_cast<uint32_t>(stoul(argv[++i]));
+        } else if(strcmp(arg, "--checkpoint-dir") == 0 && has_value) {
+            checkpoint_dir = argv[++i];
+        } else if(strcmp(arg, "--resume") == 0 && has_value) {
+            resume_path = argv[++i];
+        } else if(strcmp(arg, "--pit") == 0 && has_value) {
+            const string value = argv[++i];
+            const size_t colon = value.find(':');
+            if(colon == string::npos) {
+                cerr << "Expected DRIVER:LAP, got " << value << "\n";
+                return 1;
+            }
+            pit_overrides[static_cast<uint32_t>(stoul(value.substr(0, colon)))] = static_cast<uint32_t>(stoul(value.substr(colon + 1)));
+        } else {
+            cerr << "Unknown or incomplete option: " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    RaceCheckpoint resume_from;
+    if(!resume_path.empty()) {
+        if(!RaceCheckpoint::read(resume_path, resume_from)) {
+            cerr << "Failed to read checkpoint " << resume_path << "\n";
+            return 1;
+        }
+        // The race configuration comes from the checkpoint.
+        track_id = resume_from.track.track_id;
+        laps = resume_from.total_laps;
+        seed = resume_from.seed;
+    }
+
+    string error;
+    const shared_ptr<const ProfileTable> profiles = SeasonData::load(profiles_path, error);
+    if(!profiles) {
+        cerr << "Cannot load profiles: " << error << "\n";
+        return 1;
+    }
+    const TrackProfile* track = profiles->findTrack(track_id);
+    if(!track) {
+        cerr << "Unknown track id " << track_id << "\n";
+        return 1;
+    }
+
+    RaceSession session(*track, profiles, laps, seed);
+    if(!resume_path.empty()) {
+        if(!session.restore(resume_from)) {
+            cerr << "Checkpoint " << resume_path << " does not match the season grid\n";
+            return 1;
+        }
+        cout << "Resumed at tick " << session.tick() << " (leader on lap " << session.leaderLap() << ")\n";
+    }
+
+    for(const auto& [driver, lap] : pit_overrides) {
+        if(driver >= profiles->drivers().size()) {
+            cerr << "Driver index " << driver << " out of range\n";
+            return 1;
+        }
+    }
+    if(!pit_overrides.empty()) {
+        session.generator().setOptimalStrategies(pit_overrides);
+    }
+
+    if(checkpoint_every != 0) {
+        filesystem::create_directories(checkpoint_dir);
+        session.setCheckpointInterval(checkpoint_every, [&checkpoint_dir](const RaceCheckpoint& c) {
+            const string path = checkpoint_dir + "/lap" + to_string(c.leader_lap) + ".f1ckpt";
+            if(!c.write(path)) {
+                cerr << "Failed to write " << path << "\n";
+                return;
+            }
+            cout << "Checkpoint lap " << c.leader_lap << " -> " << path << "\n";
+        });
+    }
+
+    auto start = chrono::steady_clock::now();
+    session.run();
+    auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    vector<TelemetryFrame> classification(session.frames().begin(), session.frames().end());
+    sort(classification.begin(), classification.end(), [](const TelemetryFrame& a, const TelemetryFrame& b) {
+        return a.race_position < b.race_position;
+    });
+
+    cout << "\nFinished after " << session.tick() << " ticks in " << elapsed << " s\n\n";
+    for(const auto& frame : classification) {
+        const auto warnings = session.trackLimits().getWarnings(frame.driver_id);
+        cout << setw(3) << frame.race_position << "  "
+             << left << setw(20) << profiles->driverName(frame.driver_id) << right
+             << " lap " << setw(3) << frame.lap
+             << "  warnings " << warnings << "\n";
+    }
+
+    cout << "\nState digest: " << hex << setw(16) << setfill('0') << stateDigest(session.checkpoint()) << dec << "\n";
+    return 0;
+}
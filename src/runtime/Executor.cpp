@@ -0,0 +1,105 @@
+#include "Executor.h"
+
+using namespace std;
+
+Executor::Executor(size_t threads)
+    : thread_count_(threads == 0 ? 1 : threads), timer_seq_(0), live_tasks_(0), tasks_(nullptr) {}
+
+Executor::~Executor() {
+    // Unfinished tasks are still owned here: ones that never ran (run() was not
+    // called) and ones parked on a timer or ring. Destroying them runs the
+    // destructors of whatever their frames hold.
+    while(tasks_) {
+        Task::promise_type* promise = tasks_;
+        tasks_ = promise->next;
+        coroutine_handle<Task::promise_type>::from_promise(*promise).destroy();
+    }
+}
+
+void Executor::spawn(Task task) {
+    auto handle = task.handle_;
+    task.handle_ = nullptr;
+    auto& promise = handle.promise();
+    promise.executor = this;
+    {
+        lock_guard<mutex> lock(mutex_);
+        live_tasks_++;
+        promise.next = tasks_;
+        if(tasks_) tasks_->prev = &promise;
+        tasks_ = &promise;
+        ready_.push_back(handle);
+    }
+    cv_.notify_one();
+}
+
+void Executor::run() {
+    vector<thread> threads;
+    threads.reserve(thread_count_ - 1);
+    for(size_t i = 1; i < thread_count_; i++) {
+        threads.emplace_back([this, i]() {
+            if(thread_init_) thread_init_(i);
+            workerLoop();
+        });
+    }
+    if(thread_init_) thread_init_(0);
+    workerLoop();
+    for(auto& t : threads) {
+        t.join();
+    }
+}
+
+void Executor::schedule(coroutine_handle<> handle) {
+    {
+        lock_guard<mutex> lock(mutex_);
+        ready_.push_back(handle);
+    }
+    cv_.notify_one();
+}
+
+void Executor::addTimer(Clock::time_point deadline, coroutine_handle<> handle) {
+    {
+        lock_guard<mutex> lock(mutex_);
+        timers_.push(Timer{deadline, timer_seq_++, handle});
+    }
+    // A waiting thread may be sleeping towards a later deadline.
+    cv_.notify_one();
+}
+
+void Executor::taskDone(coroutine_handle<Task::promise_type> handle) {
+    lock_guard<mutex> lock(mutex_);
+    auto& promise = handle.promise();
+    if(promise.prev) promise.prev->next = promise.next;
+    else tasks_ = promise.next;
+    if(promise.next) promise.next->prev = promise.prev;
+    // Its locals are already gone at the final suspend point, so this only frees the frame.
+    handle.destroy();
+
+    if(--live_tasks_ == 0) {
+        cv_.notify_all();
+    }
+}
+
+void Executor::workerLoop() {
+    unique_lock<mutex> lock(mutex_);
+    while(live_tasks_ > 0) {
+        if(!timers_.empty() && timers_.top().deadline <= Clock::now()) {
+            do {
+                ready_.push_back(timers_.top().handle);
+                timers_.pop();
+            } while(!timers_.empty() && timers_.top().deadline <= Clock::now());
+            if(ready_.size() > 1) cv_.notify_one();
+        }
+
+        if(!ready_.empty()) {
+            auto handle = ready_.front();
+            ready_.pop_front();
+            lock.unlock();
+            handle.resume();
+            lock.lock();
+        } else if(!timers_.empty()) {
+            cv_.wait_until(lock, timers_.top().deadline);
+        } else {
+            cv_.wait(lock);
+        }
+    }
+}
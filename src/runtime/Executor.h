@@ -0,0 +1,139 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+class Executor;
+
+// A detached pipeline stage. The coroutine does not start until it is handed to
+// Executor::spawn(), which owns it from then on; its frame is freed as soon as it
+// returns.
+class Task {
+public:
+    struct promise_type;
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type {
+        Executor* executor = nullptr;
+        // Links in the executor's list of unfinished tasks.
+        promise_type* prev = nullptr;
+        promise_type* next = nullptr;
+
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+
+    Task(Task&& other) noexcept : handle_(other.handle_) { other.handle_ = nullptr; }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if(handle_) handle_.destroy();
+    }
+
+private:
+    friend class Executor;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+// Runs coroutine stages on a fixed number of threads. Stages suspend on ring reads
+// and writes and on timers instead of blocking, so many stages share a few threads
+// and an idle stage costs nothing. run() returns once every spawned task has
+// finished, so shutdown is just each stage returning. Destroying the executor
+// destroys every task that has not finished, whether it is queued, asleep or
+// waiting on a ring; rings (which refer to the executor) must already be gone.
+class Executor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit Executor(size_t threads);
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    // May be called before run() or from a running task.
+    void spawn(Task task);
+    // Blocks the caller until every spawned task has finished.
+    void run();
+
+    // Called on each executor thread before it runs any task, with the thread's
+    // index (0 is the thread that called run()). Used to pin threads to CPUs.
+    void setThreadInit(std::function<void(size_t)> init) { thread_init_ = std::move(init); }
+
+    // Queues a suspended coroutine to be resumed on one of the executor threads.
+    void schedule(std::coroutine_handle<> handle);
+
+    size_t threadCount() const { return thread_count_; }
+
+    class SleepAwaiter {
+    public:
+        SleepAwaiter(Executor& executor, Clock::time_point deadline) : executor_(executor), deadline_(deadline) {}
+
+        bool await_ready() const { return deadline_ <= Clock::now(); }
+        void await_suspend(std::coroutine_handle<> handle) { executor_.addTimer(deadline_, handle); }
+        void await_resume() const noexcept {}
+
+    private:
+        Executor& executor_;
+        Clock::time_point deadline_;
+    };
+
+    // co_await sleepFor(d): resumes the caller on an executor thread after `d`
+    // without holding a thread meanwhile. Replaces this_thread::sleep_for in stages.
+    SleepAwaiter sleepFor(Clock::duration duration) { return SleepAwaiter(*this, Clock::now() + duration); }
+    SleepAwaiter sleepUntil(Clock::time_point deadline) { return SleepAwaiter(*this, deadline); }
+
+private:
+    friend struct Task::FinalAwaiter;
+
+    struct Timer {
+        Clock::time_point deadline;
+        uint64_t seq;               // FIFO among equal deadlines
+        std::coroutine_handle<> handle;
+
+        bool operator>(const Timer& other) const {
+            return deadline > other.deadline || (deadline == other.deadline && seq > other.seq);
+        }
+    };
+
+    size_t thread_count_;
+    std::function<void(size_t)> thread_init_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::coroutine_handle<>> ready_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+    uint64_t timer_seq_;
+    size_t live_tasks_;
+    // Every spawned task that has not finished, wherever it is suspended.
+    Task::promise_type* tasks_;
+
+    void addTimer(Clock::time_point deadline, std::coroutine_handle<> handle);
+    void taskDone(std::coroutine_handle<Task::promise_type> handle);
+    void workerLoop();
+};
+
+inline void Task::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+    handle.promise().executor->taskDone(handle);
+}
@@ -0,0 +1,41 @@
+#include "NumaMemoryResource.h"
+#include <new>
+
+#ifdef F1_HAVE_NUMA
+#include <numa.h>
+#endif
+
+using namespace std;
+
+NumaMemoryResource::NumaMemoryResource(int node, pmr::memory_resource* upstream)
+    : node_(node), bound_(false), upstream_(upstream) {
+#ifdef F1_HAVE_NUMA
+    bound_ = node >= 0 && numa_available() != -1 && node <= numa_max_node();
+#endif
+}
+
+void* NumaMemoryResource::do_allocate(size_t bytes, size_t alignment) {
+#ifdef F1_HAVE_NUMA
+    // numa_alloc_onnode() hands out whole pages, which covers any fundamental alignment.
+    if(bound_) {
+        void* p = numa_alloc_onnode(bytes, node_);
+        if(!p) throw bad_alloc();
+        return p;
+    }
+#endif
+    return upstream_->allocate(bytes, alignment);
+}
+
+void NumaMemoryResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+#ifdef F1_HAVE_NUMA
+    if(bound_) {
+        numa_free(p, bytes);
+        return;
+    }
+#endif
+    upstream_->deallocate(p, bytes, alignment);
+}
+
+bool NumaMemoryResource::do_is_equal(const pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
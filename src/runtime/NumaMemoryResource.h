@@ -0,0 +1,25 @@
+#pragma once
+
+#include <memory_resource>
+#include <cstddef>
+
+// Allocates from one NUMA node through libnuma, so per-stage buffers live next to
+// the cores that use them. Without libnuma (or on a non-NUMA kernel, or node < 0)
+// it forwards to `upstream`.
+class NumaMemoryResource : public std::pmr::memory_resource {
+public:
+    explicit NumaMemoryResource(int node, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    // True when allocations are actually bound to the node.
+    bool bound() const { return bound_; }
+    int node() const { return node_; }
+
+private:
+    int node_;
+    bool bound_;
+    std::pmr::memory_resource* upstream_;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
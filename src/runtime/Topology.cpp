@@ -0,0 +1,172 @@
+#include "Topology.h"
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <cstdlib>
+#include <pthread.h>
+#include <sched.h>
+
+using namespace std;
+
+namespace {
+
+int readInt(const string& path) {
+    ifstream in(path);
+    int value = -1;
+    if(!(in >> value)) return -1;
+    return value;
+}
+
+CpuInfo readCpu(int cpu) {
+    const string base = "/sys/devices/system/cpu/cpu" + to_string(cpu);
+    CpuInfo info{cpu, readInt(base + "/topology/core_id"), readInt(base + "/topology/physical_package_id"), -1, -1};
+
+    error_code ec;
+    for(const auto& entry : filesystem::directory_iterator(base, ec)) {
+        const string name = entry.path().filename().string();
+        if(name.size() > 4 && name.compare(0, 4, "node") == 0) {
+            info.node = atoi(name.c_str() + 4);
+            break;
+        }
+    }
+
+    // The highest-level cache index is the LLC; its id is unique per level.
+    int best_level = -1;
+    for(int index = 0; ; index++) {
+        const string cache = base + "/cache/index" + to_string(index);
+        const int level = readInt(cache + "/level");
+        if(level < 0) break;
+        if(level > best_level) {
+            best_level = level;
+            info.llc = readInt(cache + "/id");
+        }
+    }
+    return info;
+}
+
+string formatCpus(const vector<int>& cpus) {
+    ostringstream os;
+    for(size_t i = 0; i < cpus.size(); i++) {
+        if(i > 0) os << ",";
+        os << cpus[i];
+    }
+    return os.str();
+}
+
+} // namespace
+
+void ThreadPlacement::describe(ostream& os) const {
+    if(!enabled()) {
+        os << "Thread placement: left to the scheduler\n";
+        return;
+    }
+    os << "Thread placement: pipeline on CPUs " << (pipeline_cpus.empty() ? "any" : formatCpus(pipeline_cpus));
+    if(numa_node >= 0) os << " (node " << numa_node << ")";
+    os << ", strategy workers on " << (strategy_cpus.empty() ? "any" : formatCpus(strategy_cpus)) << "\n";
+}
+
+Topology Topology::detect() {
+    Topology t;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0, sizeof(set), &set) != 0) return t;
+
+    for(int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if(CPU_ISSET(cpu, &set)) {
+            t.cpus_.push_back(readCpu(cpu));
+        }
+    }
+    return t;
+}
+
+ThreadPlacement Topology::plan(size_t pipeline_threads) const {
+    ThreadPlacement p;
+    if(cpus_.empty() || pipeline_threads == 0) return p;
+
+    // Largest (node, LLC) group; ties go to the lowest ids.
+    map<pair<int, int>, vector<const CpuInfo*>> groups;
+    for(const auto& c : cpus_) {
+        groups[{c.node, c.llc}].push_back(&c);
+    }
+    const vector<const CpuInfo*>* group = nullptr;
+    for(const auto& [key, members] : groups) {
+        if(!group || members.size() > group->size()) group = &members;
+    }
+
+    // First pass takes one CPU per physical core, second pass the SMT siblings.
+    set<pair<int, int>> used_cores;
+    for(int pass = 0; pass < 2 && p.pipeline_cpus.size() < pipeline_threads; pass++) {
+        for(const CpuInfo* c : *group) {
+            if(p.pipeline_cpus.size() == pipeline_threads) break;
+            if(find(p.pipeline_cpus.begin(), p.pipeline_cpus.end(), c->cpu) != p.pipeline_cpus.end()) continue;
+            const pair<int, int> core{c->package, c->core};
+            if(pass == 0 && used_cores.count(core)) continue;
+            used_cores.insert(core);
+            p.pipeline_cpus.push_back(c->cpu);
+        }
+    }
+    p.numa_node = nodeOf(p.pipeline_cpus[0]);
+
+    vector<int> siblings;
+    for(const auto& c : cpus_) {
+        if(find(p.pipeline_cpus.begin(), p.pipeline_cpus.end(), c.cpu) != p.pipeline_cpus.end()) continue;
+        if(used_cores.count({c.package, c.core})) siblings.push_back(c.cpu);
+        else p.strategy_cpus.push_back(c.cpu);
+    }
+    if(p.strategy_cpus.empty()) p.strategy_cpus = siblings;
+    return p;
+}
+
+ThreadPlacement Topology::placementFromEnvironment(size_t pipeline_threads) const {
+    ThreadPlacement p;
+    const char* mode = getenv("F1_AFFINITY");
+    if(mode && string(mode) == "auto") {
+        p = plan(pipeline_threads);
+    }
+    if(const char* list = getenv("F1_PIPELINE_CPUS")) {
+        p.pipeline_cpus = parseCpuList(list);
+        p.numa_node = p.pipeline_cpus.empty() ? -1 : nodeOf(p.pipeline_cpus[0]);
+    }
+    if(const char* list = getenv("F1_STRATEGY_CPUS")) {
+        p.strategy_cpus = parseCpuList(list);
+    }
+    return p;
+}
+
+int Topology::nodeOf(int cpu) const {
+    for(const auto& c : cpus_) {
+        if(c.cpu == cpu) return c.node;
+    }
+    return -1;
+}
+
+vector<int> Topology::parseCpuList(const string& list) {
+    vector<int> cpus;
+    stringstream ss(list);
+    string item;
+    while(getline(ss, item, ',')) {
+        if(item.empty()) continue;
+        try {
+            const size_t dash = item.find('-');
+            const int first = stoi(item.substr(0, dash));
+            const int last = (dash == string::npos) ? first : stoi(item.substr(dash + 1));
+            for(int cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) {
+                if(cpu >= 0) cpus.push_back(cpu);
+            }
+        } catch(...) {
+            // Skip invalid entries
+        }
+    }
+    return cpus;
+}
+
+bool Topology::pinCurrentThread(int cpu) {
+    if(cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
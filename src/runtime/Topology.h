@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstddef>
+
+// One logical CPU this process may run on, as reported by sysfs. Unknown fields are -1.
+struct CpuInfo {
+    int cpu;
+    int core;      // physical core id within the package (SMT siblings share it)
+    int package;   // socket
+    int node;      // NUMA node
+    int llc;       // id of the last-level cache this CPU shares
+};
+
+// Where the pipeline and strategy threads should run. Empty CPU lists mean the
+// threads are left to the scheduler.
+struct ThreadPlacement {
+    std::vector<int> pipeline_cpus;   // executor thread i runs on pipeline_cpus[i % size]
+    std::vector<int> strategy_cpus;   // strategy worker i runs on strategy_cpus[i % size]
+    int numa_node = -1;               // node of the pipeline CPUs, for stage buffers
+
+    bool enabled() const { return !pipeline_cpus.empty() || !strategy_cpus.empty(); }
+    void describe(std::ostream& os) const;
+};
+
+class Topology {
+public:
+    // CPUs in this process's affinity mask, in id order.
+    static Topology detect();
+
+    const std::vector<CpuInfo>& cpus() const { return cpus_; }
+
+    // Pipeline threads go on distinct physical cores that share the largest
+    // last-level cache (falling back to SMT siblings, then wrapping round), so ring
+    // traffic stays in that cache. Strategy workers get the remaining CPUs, skipping
+    // SMT siblings of the pipeline cores while others are left.
+    ThreadPlacement plan(size_t pipeline_threads) const;
+
+    // Runtime configuration:
+    //   F1_AFFINITY=auto         use plan()
+    //   F1_PIPELINE_CPUS=2,3     explicit executor CPUs (lists accept ranges: 4-7)
+    //   F1_STRATEGY_CPUS=4-15    explicit strategy worker CPUs
+    // Explicit lists override the automatic plan; nothing set leaves placement to the OS.
+    ThreadPlacement placementFromEnvironment(size_t pipeline_threads) const;
+
+    int nodeOf(int cpu) const;
+
+    // "0-3,8" -> {0, 1, 2, 3, 8}; invalid entries are skipped.
+    static std::vector<int> parseCpuList(const std::string& list);
+    static bool pinCurrentThread(int cpu);
+
+private:
+    std::vector<CpuInfo> cpus_;
+};
@@ -0,0 +1,82 @@
+#include "transport/ShmReader.h"
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstring>
+
+using namespace std;
+
+void printUsage(){
+    cout << "Usage: f1-shm-tail [options]\n"
+         << "  --name NAME     shared-memory ring to read (default: /f1-telemetry)\n"
+         << "  --from-oldest   start at the oldest frame still in the ring, not the newest\n"
+         << "  --count N       exit after N frames (default: until the race ends)\n";
+}
+
+// Example out-of-process consumer: follows the race published by f1-telemetry
+// (F1_SHM_NAME) and prints the leader at each new leader lap.
+int main(int argc, char** argv){
+    string name = "/f1-telemetry";
+    bool from_oldest = false;
+    uint64_t count = 0;
+
+    for(int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const bool has_value = (i + 1 < argc);
+
+        if(strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            printUsage();
+            return 0;
+        } else if(strcmp(arg, "--name") == 0 && has_value) {
+            name = argv[++i];
+        } else if(strcmp(arg, "--from-oldest") == 0) {
+            from_oldest = true;
+        } else if(strcmp(arg, "--count") == 0 && has_value) {
+            count = stoull(argv[++i]);
+        } else {
+            cerr << "Unknown or incomplete option: " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    ShmReader reader;
+    if(!reader.attach(name, from_oldest)) {
+        cerr << "Cannot attach: " << reader.error() << "\n";
+        return 1;
+    }
+    cout << "Attached to " << name << " (" << reader.driverCount() << " drivers)\n";
+
+    uint64_t frames_read = 0;
+    uint32_t leader_lap = 0;
+    while(!reader.finished() && (count == 0 || frames_read < count)) {
+        const TelemetryFrame* frame = reader.peek();
+        if(!frame) {
+            if(!reader.writerAlive()) {
+                cerr << "Writer exited without finishing the race\n";
+                break;
+            }
+            this_thread::sleep_for(chrono::milliseconds(1));
+            continue;
+        }
+
+        // Read the fields in place, then keep them only if the frame was intact.
+        const uint32_t position = frame->race_position;
+        const uint32_t lap = frame->lap;
+        const uint32_t driver = frame->driver_id;
+        const float speed = frame->speed_kph;
+        if(!reader.advance()) continue;
+        frames_read++;
+
+        if(position == 1 && lap > leader_lap) {
+            leader_lap = lap;
+            cout << "Lap " << lap << ": leader #" << driver << " at " << int(speed) << " kph"
+                 << " (" << frames_read << " frames read, " << reader.lost() << " lost)\n";
+        }
+    }
+
+    cout << "Read " << frames_read << " frames, lost " << reader.lost() << "\n";
+    return 0;
+}
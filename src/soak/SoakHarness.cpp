@@ -0,0 +1,389 @@
+#include "SoakHarness.h"
+#include "../common/SimKernel.h"
+#include "../ingestion/RingBuffer.h"
+#include "../ingestion/AsyncRingBuffer.h"
+#include "../monitoring/CycleClock.h"
+#include "../runtime/Executor.h"
+#include <chrono>
+#include <functional>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+// Randomized stall lengths for one thread or stage.
+class Stalls {
+public:
+    Stalls(float probability, uint32_t max_us, uint32_t seed)
+        : probability_(probability), gen_(seed), chance_(0.0f, 1.0f), length_(0, max_us) {}
+
+    // Microseconds to stall for now; 0 most of the time.
+    uint32_t next() {
+        if(probability_ <= 0.0f || chance_(gen_) >= probability_) return 0;
+        return length_(gen_);
+    }
+
+private:
+    float probability_;
+    mt19937 gen_;
+    uniform_real_distribution<float> chance_;
+    uniform_int_distribution<uint32_t> length_;
+};
+
+uint32_t stateRank(PenaltyState state) {
+    switch(state) {
+        case PenaltyState::NONE: return 0;
+        case PenaltyState::PENDING: return 1;
+        case PenaltyState::SERVING: return 2;
+        case PenaltyState::SERVED: return 3;
+    }
+    return 0;
+}
+
+const char* stateName(PenaltyState state) {
+    switch(state) {
+        case PenaltyState::NONE: return "NONE";
+        case PenaltyState::PENDING: return "PENDING";
+        case PenaltyState::SERVING: return "SERVING";
+        case PenaltyState::SERVED: return "SERVED";
+    }
+    return "?";
+}
+
+// Stream failures listed per round before the rest are only counted.
+constexpr size_t MAX_LISTED_FAILURES = 8;
+
+} // namespace
+
+struct SoakHarness::Round {
+    uint32_t index;
+    vector<unique_ptr<Race>> races;
+    vector<StreamTally> streams;       // race * driver_count + driver
+    vector<Consumer> consumers;
+
+    // Producer 0 shuts the rings down when it reaches stop_tick (0 = never).
+    uint64_t stop_tick = 0;
+    atomic<bool> stop{false};
+    function<void()> shut_down;
+
+    atomic<uint64_t> evicted{0};
+};
+
+SoakHarness::Race::Race(const SoakConfig& config, const shared_ptr<const ProfileTable>& profiles, uint32_t seed)
+    : penalties(make_shared<PenaltyEnforcer>(profiles->drivers().size())),
+      generator(config.track, profiles, config.laps, penalties),
+      track_limits(config.track, profiles, penalties, seed),
+      frames(profiles->drivers().size(), TelemetryFrame{}),
+      accepted(profiles->drivers().size(), 0),
+      first_timestamp_ns(0), last_timestamp_ns(0) {}
+
+SoakHarness::SoakHarness(const SoakConfig& config, shared_ptr<const ProfileTable> profiles)
+    : config_(config), profiles_(std::move(profiles)), driver_count_(profiles_->drivers().size()) {}
+
+SoakRoundResult SoakHarness::runRound(uint32_t index, SoakPath path) {
+    Round round;
+    round.index = index;
+    const uint32_t seed = config_.seed + index * 7919u;
+    for(uint32_t r = 0; r < config_.producers; r++) {
+        round.races.push_back(make_unique<Race>(config_, profiles_, seed + r));
+    }
+    round.streams.resize(config_.producers * driver_count_);
+    round.consumers.resize(config_.consumers);
+
+    // Shut down somewhere in the race's expected length, at roughly race pace.
+    mt19937 gen(seed);
+    if(uniform_real_distribution<float>(0.0f, 1.0f)(gen) < config_.early_shutdown_probability) {
+        const float km_per_tick = 200.0f * (SimKernel::TICK_SECONDS / 3600.0f) * SimKernel::SIM_SPEED_MULTIPLIER;
+        const auto race_ticks = static_cast<uint64_t>(config_.laps * config_.track.lap_length_km / km_per_tick);
+        round.stop_tick = uniform_int_distribution<uint64_t>(1, max<uint64_t>(race_ticks, 1))(gen);
+    }
+
+    vector<string> watcher_failures;
+    atomic<bool> done{false};
+    thread watcher([&]() { watchPenalties(round, done, watcher_failures); });
+
+    const auto start = chrono::steady_clock::now();
+    if(path == SoakPath::BLOCKING) {
+        runBlocking(round);
+    } else {
+        runAsync(round);
+    }
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    done.store(true);
+    watcher.join();
+
+    SoakRoundResult result{};
+    result.path = path;
+    result.shut_down_early = round.stop.load();
+    result.seconds = seconds;
+    result.failures = std::move(watcher_failures);
+    check(round, result);
+    return result;
+}
+
+void SoakHarness::consume(Round& round, Consumer& consumer, const SoakFrame& item) {
+    const TelemetryFrame& frame = item.frame;
+    auto& tally = round.streams[item.race * driver_count_ + frame.driver_id];
+    const uint64_t ts = frame.timestamp_ns;
+
+    if(tally.count == 0) {
+        tally.first_ns = ts;
+        tally.last_ns = ts;
+    } else if(ts == tally.last_ns) {
+        tally.duplicates++;
+    } else if(ts < tally.last_ns) {
+        tally.reordered++;
+    } else {
+        if(ts != tally.last_ns + SimKernel::TICK_NS) tally.gaps++;
+        tally.last_ns = ts;
+    }
+    tally.count++;
+
+    // Drivers of one race are spread over the consumers, so the monitor and the
+    // enforcer behind it are hit from several consumers and the producer at once.
+    round.races[item.race]->track_limits.processFrame(frame);
+
+    consumer.latency->record(CycleClock::now() - item.generated_at);
+    consumer.consumed++;
+}
+
+void SoakHarness::watchPenalties(Round& round, atomic<bool>& done, vector<string>& failures) {
+    // Polls every driver like the renderer does and checks that no state is ever
+    // seen to go backwards.
+    vector<PenaltyState> last(round.races.size() * driver_count_, PenaltyState::NONE);
+    auto sweep = [&]() {
+        for(size_t r = 0; r < round.races.size(); r++) {
+            for(uint32_t d = 0; d < driver_count_; d++) {
+                const DriverPenaltyInfo info = round.races[r]->penalties->getPenaltyInfo(d);
+                round.races[r]->track_limits.getWarnings(d);
+
+                auto& seen = last[r * driver_count_ + d];
+                if(stateRank(info.state) < stateRank(seen)) {
+                    failures.push_back("race " + to_string(r) + " driver " + to_string(d) + ": penalty went from "
+                                       + stateName(seen) + " back to " + stateName(info.state));
+                }
+                if(info.state != PenaltyState::NONE && info.penalty_duration_ns != info.penalty_seconds * 1'000'000'000ULL) {
+                    failures.push_back("race " + to_string(r) + " driver " + to_string(d) + ": penalty duration does not match its seconds");
+                }
+                seen = info.state;
+            }
+        }
+    };
+
+    while(!done.load() && failures.size() < MAX_LISTED_FAILURES) {
+        sweep();
+        this_thread::sleep_for(chrono::microseconds(200));
+    }
+    sweep();
+}
+
+void SoakHarness::runBlocking(Round& round) {
+    using Ring = RingBuffer<SoakFrame>;
+    vector<unique_ptr<Ring>> rings;
+    for(uint32_t c = 0; c < config_.consumers; c++) {
+        rings.push_back(make_unique<Ring>(config_.ring_capacity));
+    }
+    auto shut_down = [&rings]() {
+        for(auto& ring : rings) ring->shutdown();
+    };
+    round.shut_down = shut_down;
+
+    vector<thread> consumers;
+    for(uint32_t c = 0; c < config_.consumers; c++) {
+        consumers.emplace_back([this, &round, &rings, c]() {
+            Stalls stalls(config_.stall_probability, config_.max_stall_us, config_.seed + round.index * 131u + 1000u + c);
+            SoakFrame item;
+            while(rings[c]->pop(item)) {
+                if(const uint32_t us = stalls.next()) this_thread::sleep_for(chrono::microseconds(us));
+                consume(round, round.consumers[c], item);
+            }
+        });
+    }
+
+    vector<thread> producers;
+    for(uint32_t r = 0; r < config_.producers; r++) {
+        producers.emplace_back([this, &round, &rings, r]() {
+            Race& race = *round.races[r];
+            Stalls stalls(config_.stall_probability, config_.max_stall_us, config_.seed + round.index * 131u + r);
+
+            // Pushes under the overflow policy; false once the round is stopping.
+            auto push = [&](const SoakFrame& item, Ring& ring) {
+                SoakFrame oldest;
+                while(!ring.push(item)) {
+                    if(round.stop.load()) return false;
+                    if(config_.overflow == OverflowPolicy::DROP_OLDEST && ring.tryPop(oldest)) {
+                        round.evicted.fetch_add(1);
+                    } else {
+                        this_thread::yield();
+                    }
+                }
+                return true;
+            };
+
+            for(uint64_t tick = 1; !race.generator.isRaceFinished() && !round.stop.load(); tick++) {
+                if(const uint32_t us = stalls.next()) this_thread::sleep_for(chrono::microseconds(us));
+
+                race.generator.next(race.frames);
+                if(tick == 1) race.first_timestamp_ns = race.frames[0].timestamp_ns;
+                race.last_timestamp_ns = race.frames[0].timestamp_ns;
+
+                SoakFrame item{{}, r, CycleClock::now()};
+                for(const auto& frame : race.frames) {
+                    item.frame = frame;
+                    if(!push(item, *rings[(r * driver_count_ + frame.driver_id) % rings.size()])) return;
+                    race.accepted[frame.driver_id]++;
+                }
+
+                if(r == 0 && tick == round.stop_tick) {
+                    round.stop.store(true);
+                    round.shut_down();
+                }
+            }
+        });
+    }
+
+    for(auto& t : producers) t.join();
+    shut_down();
+    for(auto& t : consumers) t.join();
+}
+
+// Coroutine stages for the ASYNC path. Nested so they can reach the round state.
+struct SoakHarness::AsyncStages {
+    using Ring = AsyncRingBuffer<SoakFrame>;
+
+    static Task produce(SoakHarness& h, Round& round, uint32_t r, vector<unique_ptr<Ring>>& rings, Executor& executor, atomic<uint32_t>& live) {
+        Race& race = *round.races[r];
+        Stalls stalls(h.config_.stall_probability, h.config_.max_stall_us, h.config_.seed + round.index * 131u + r);
+
+        for(uint64_t tick = 1; !race.generator.isRaceFinished() && !round.stop.load(); tick++) {
+            if(const uint32_t us = stalls.next()) co_await executor.sleepFor(chrono::microseconds(us));
+
+            race.generator.next(race.frames);
+            if(tick == 1) race.first_timestamp_ns = race.frames[0].timestamp_ns;
+            race.last_timestamp_ns = race.frames[0].timestamp_ns;
+
+            bool open = true;
+            SoakFrame item{{}, r, CycleClock::now()};
+            for(const auto& frame : race.frames) {
+                item.frame = frame;
+                open = co_await rings[(r * h.driver_count_ + frame.driver_id) % rings.size()]->push(item);
+                if(!open) break;
+                race.accepted[frame.driver_id]++;
+            }
+            if(!open) break;
+
+            if(r == 0 && tick == round.stop_tick) {
+                round.stop.store(true);
+                round.shut_down();
+            }
+        }
+
+        // The last producer out ends the streams.
+        if(live.fetch_sub(1) == 1) {
+            for(auto& ring : rings) ring->close();
+        }
+    }
+
+    static Task consume(SoakHarness& h, Round& round, uint32_t c, Ring& ring, Executor& executor) {
+        Stalls stalls(h.config_.stall_probability, h.config_.max_stall_us, h.config_.seed + round.index * 131u + 1000u + c);
+        SoakFrame item;
+        while(co_await ring.pop(item)) {
+            if(const uint32_t us = stalls.next()) co_await executor.sleepFor(chrono::microseconds(us));
+            h.consume(round, round.consumers[c], item);
+        }
+    }
+};
+
+void SoakHarness::runAsync(Round& round) {
+    using Ring = AsyncStages::Ring;
+    Executor executor(config_.executor_threads);
+    vector<unique_ptr<Ring>> rings;
+    for(uint32_t c = 0; c < config_.consumers; c++) {
+        rings.push_back(make_unique<Ring>(config_.ring_capacity, executor));
+    }
+    round.shut_down = [&rings]() {
+        for(auto& ring : rings) ring->close();
+    };
+
+    atomic<uint32_t> live{config_.producers};
+    for(uint32_t c = 0; c < config_.consumers; c++) {
+        executor.spawn(AsyncStages::consume(*this, round, c, *rings[c], executor));
+    }
+    for(uint32_t r = 0; r < config_.producers; r++) {
+        executor.spawn(AsyncStages::produce(*this, round, r, rings, executor, live));
+    }
+    executor.run();
+}
+
+void SoakHarness::check(Round& round, SoakRoundResult& result) {
+    // The async ring always applies backpressure; only DROP_OLDEST on RingBuffer loses frames.
+    const bool lossless = result.path == SoakPath::ASYNC || config_.overflow == OverflowPolicy::BLOCK;
+    size_t stream_failures = 0;
+    auto fail = [&](const string& message) {
+        if(stream_failures++ < MAX_LISTED_FAILURES) result.failures.push_back(message);
+    };
+
+    for(size_t r = 0; r < round.races.size(); r++) {
+        const Race& race = *round.races[r];
+        for(uint32_t d = 0; d < driver_count_; d++) {
+            const StreamTally& tally = round.streams[r * driver_count_ + d];
+            const string stream = "race " + to_string(r) + " driver " + to_string(d) + ": ";
+            result.accepted += race.accepted[d];
+
+            if(tally.duplicates != 0) fail(stream + to_string(tally.duplicates) + " duplicated frames");
+            if(tally.reordered != 0) fail(stream + to_string(tally.reordered) + " frames out of order");
+            if(lossless) {
+                if(tally.count != race.accepted[d]) {
+                    fail(stream + to_string(race.accepted[d]) + " frames accepted but " + to_string(tally.count) + " consumed");
+                }
+                if(tally.gaps != 0) fail(stream + to_string(tally.gaps) + " gaps in the timestamps");
+                if(tally.count != 0 && tally.first_ns != race.first_timestamp_ns) fail(stream + "first frame missing");
+            }
+
+            // Track-limits warnings, the monitor's penalty flag and the enforcer must agree.
+            const TrackLimitsState limits = race.track_limits.getDriverState(d);
+            const DriverPenaltyInfo info = race.penalties->getPenaltyInfo(d);
+            if((limits.warnings >= 3) != limits.has_penalty) {
+                fail(stream + to_string(limits.warnings) + " warnings but penalty flag " + (limits.has_penalty ? "set" : "clear"));
+            }
+            if(limits.has_penalty != (info.state != PenaltyState::NONE)) {
+                fail(stream + "penalty flag and enforcer state " + stateName(info.state) + " disagree");
+            }
+            if(info.state == PenaltyState::SERVED && info.penalty_start_time_ns + info.penalty_duration_ns > race.last_timestamp_ns) {
+                fail(stream + "penalty served before its time was up");
+            }
+            if(info.state != PenaltyState::NONE) result.penalties_issued++;
+            if(info.state == PenaltyState::SERVED) result.penalties_served++;
+        }
+    }
+    if(stream_failures > MAX_LISTED_FAILURES) {
+        result.failures.push_back("... and " + to_string(stream_failures - MAX_LISTED_FAILURES) + " more");
+    }
+
+    LatencyHistogram::Snapshot latency;
+    for(const auto& consumer : round.consumers) {
+        const auto s = consumer.latency->snapshot();
+        for(size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; i++) latency.counts[i] += s.counts[i];
+        latency.total += s.total;
+        result.consumed += consumer.consumed;
+    }
+    result.evicted = round.evicted.load();
+    if(result.accepted != result.consumed + result.evicted) {
+        result.failures.push_back(to_string(result.accepted) + " frames accepted but " + to_string(result.consumed)
+                                  + " consumed and " + to_string(result.evicted) + " evicted");
+    }
+
+    result.frames_per_s = result.seconds > 0.0 ? static_cast<double>(result.consumed) / result.seconds : 0.0;
+    result.p99_us = static_cast<double>(latency.percentile(0.99)) / CycleClock::ticksPerNs() / 1000.0;
+    if(config_.min_frames_per_s > 0.0 && result.frames_per_s < config_.min_frames_per_s) {
+        result.failures.push_back("throughput " + to_string(static_cast<uint64_t>(result.frames_per_s)) + " frames/s is below the floor of "
+                                  + to_string(static_cast<uint64_t>(config_.min_frames_per_s)));
+    }
+    if(config_.max_p99_us > 0.0 && result.p99_us > config_.max_p99_us) {
+        result.failures.push_back("p99 latency " + to_string(static_cast<uint64_t>(result.p99_us)) + " us is above the ceiling of "
+                                  + to_string(static_cast<uint64_t>(config_.max_p99_us)) + " us");
+    }
+}
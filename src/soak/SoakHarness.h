@@ -0,0 +1,132 @@
+#pragma once
+
+#include "../common/types.h"
+#include "../data/ProfileTable.h"
+#include "../race-control/PenaltyEnforcer.h"
+#include "../race-control/TrackLimitsMonitor.h"
+#include "../telemetry/TelemetryGenerator.h"
+#include "../monitoring/LatencyHistogram.h"
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <atomic>
+
+// Which ring the frames travel through.
+enum class SoakPath {
+    BLOCKING,   // RingBuffer between plain threads
+    ASYNC       // AsyncRingBuffer between coroutine stages, as in the live pipeline
+};
+
+// What a RingBuffer producer does when the ring is full. The async ring always
+// applies backpressure.
+enum class OverflowPolicy {
+    BLOCK,        // retry until there is space; nothing may be lost
+    DROP_OLDEST   // evict the oldest frame and retry
+};
+
+struct SoakConfig {
+    TrackProfile track;
+    uint32_t laps;
+    uint32_t producers;          // one race per producer
+    uint32_t consumers;          // one ring per consumer; frames are routed by driver
+    size_t ring_capacity;
+    uint32_t executor_threads;   // ASYNC path only
+    OverflowPolicy overflow;
+
+    // Stalls: before each producer tick and each consumed frame, with this
+    // probability, for a uniform 0..max_stall_us.
+    float stall_probability;
+    uint32_t max_stall_us;
+    // Chance per round that the rings are shut down while the races are still running.
+    float early_shutdown_probability;
+    uint32_t seed;
+
+    double min_frames_per_s;     // 0 = no floor
+    double max_p99_us;           // 0 = no ceiling
+};
+
+struct SoakRoundResult {
+    SoakPath path;
+    bool shut_down_early;
+    uint64_t accepted;           // frames the rings took
+    uint64_t consumed;
+    uint64_t evicted;            // DROP_OLDEST only
+    double seconds;
+    double frames_per_s;
+    double p99_us;
+    uint32_t penalties_issued;
+    uint32_t penalties_served;
+    // Broken invariants and missed floors; empty when the round passed.
+    std::vector<std::string> failures;
+
+    bool passed() const { return failures.empty(); }
+};
+
+// Concurrency soak: each round runs `producers` headless races at full speed into
+// `consumers` rings, with randomized stalls on both sides, and checks:
+//
+//   - every frame a ring accepted is consumed exactly once (or was evicted under
+//     DROP_OLDEST), including when the rings are shut down mid-race;
+//   - each driver's timestamps arrive in order, one tick apart unless frames
+//     were evicted;
+//   - penalties only move forward (NONE -> PENDING -> SERVING -> SERVED) while the
+//     producer serves them and consumers issue them through the track-limits
+//     monitor, and end consistent with the monitor's warnings;
+//   - throughput and p99 enqueue-to-consume latency meet the configured floors.
+class SoakHarness {
+public:
+    SoakHarness(const SoakConfig& config, std::shared_ptr<const ProfileTable> profiles);
+
+    SoakRoundResult runRound(uint32_t round, SoakPath path);
+
+private:
+    // A frame in flight, tagged with its race and the time it was generated.
+    struct SoakFrame {
+        TelemetryFrame frame;
+        uint32_t race;
+        uint64_t generated_at;
+    };
+
+    struct Race {
+        std::shared_ptr<PenaltyEnforcer> penalties;
+        TelemetryGenerator generator;
+        TrackLimitsMonitor track_limits;
+        std::vector<TelemetryFrame> frames;
+        std::vector<uint64_t> accepted;     // per driver, written by the producer
+        uint64_t first_timestamp_ns;
+        uint64_t last_timestamp_ns;
+
+        Race(const SoakConfig& config, const std::shared_ptr<const ProfileTable>& profiles, uint32_t seed);
+    };
+
+    // What one consumer saw of one (race, driver) stream.
+    struct StreamTally {
+        uint64_t count = 0;
+        uint64_t first_ns = 0;
+        uint64_t last_ns = 0;
+        uint64_t gaps = 0;
+        uint64_t duplicates = 0;
+        uint64_t reordered = 0;
+    };
+
+    struct Consumer {
+        std::unique_ptr<LatencyHistogram> latency = std::make_unique<LatencyHistogram>();
+        uint64_t consumed = 0;
+    };
+
+    // Shared state of one round.
+    struct Round;
+    // Producer and consumer coroutines for the ASYNC path.
+    struct AsyncStages;
+
+    SoakConfig config_;
+    std::shared_ptr<const ProfileTable> profiles_;
+    size_t driver_count_;
+
+    void consume(Round& round, Consumer& consumer, const SoakFrame& item);
+    void watchPenalties(Round& round, std::atomic<bool>& done, std::vector<std::string>& failures);
+    void runBlocking(Round& round);
+    void runAsync(Round& round);
+    void check(Round& round, SoakRoundResult& result);
+};
@@ -0,0 +1,174 @@
+#include "soak/SoakHarness.h"
+#include "data/season_data.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cstring>
+
+using namespace std;
+
+void printUsage(){
+    cout << "Usage: f1-soak [options]\n"
+         << "  --profiles PATH        season profile file (default: built-in 2025 season)\n"
+         << "  --track N              track id from the season track library (default: 1)\n"
+         << "  --laps N               race length per producer and round (default: 52)\n"
+         << "  --producers N          concurrent races (default: 4)\n"
+         << "  --consumers N          consumer rings, frames routed by driver (default: 2)\n"
+         << "  --ring N               ring capacity in frames (default: 256)\n"
+         << "  --path P               blocking, async or both, alternating by round (default: both)\n"
+         << "  --overflow P           blocking ring on overflow: block or drop-oldest (default: block)\n"
+         << "  --executor-threads N   threads for the async path (default: 2)\n"
+         << "  --stall-prob P         chance of a stall per producer tick and consumed frame (default: 0.002)\n"
+         << "  --max-stall-us N       longest stall (default: 2000)\n"
+         << "  --early-shutdown P     chance per round of shutting the rings down mid-race (default: 0.25)\n"
+         << "  --duration S           keep running rounds for S seconds (default: 10)\n"
+         << "  --rounds N             stop after N rounds instead (default: off)\n"
+         << "  --seed N               base seed (default: 1)\n"
+         << "  --min-throughput N     fail a round below N consumed frames/s (default: off)\n"
+         << "  --max-p99-us N         fail a round above N us p99 enqueue-to-consume latency (default: off)\n";
+}
+
+int main(int argc, char** argv){
+    SoakConfig config{};
+    config.laps = 52;
+    config.producers = 4;
+    config.consumers = 2;
+    config.ring_capacity = 256;
+    config.executor_threads = 2;
+    config.overflow = OverflowPolicy::BLOCK;
+    config.stall_probability = 0.002f;
+    config.max_stall_us = 2000;
+    config.early_shutdown_probability = 0.25f;
+    config.seed = 1;
+    config.min_frames_per_s = 0.0;
+    config.max_p99_us = 0.0;
+
+    uint32_t track_id = 1;
+    string profiles_path;
+    string path = "both";
+    double duration_s = 10.0;
+    uint32_t max_rounds = 0;
+
+    for(int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const bool has_value = (i + 1 < argc);
+
+        if(strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            printUsage();
+            return 0;
+        } else if(strcmp(arg, "--profiles") == 0 && has_value) {
+            profiles_path = argv[++i];
+        } else if(strcmp(arg, "--track") == 0 && has_value) {
+            track_id = static_cast<uint32_t>(stoul(argv[++i]));
+        } else if(strcmp(arg, "--laps") == 0 && has_value) {
+            config.laps = static_cast<uint32_t>(stoul(argv[++i]));
+        } else if(strcmp(arg, "--producers") == 0 && has_value) {
+            config.producers = static_cast<uint32_t>(stoul(argv[++i]));
+        } else if(strcmp(arg, "--consumers") == 0 && has_value) {
+            config.consumers = static_cast<uint32_t>(stoul(argv[++i]));
+        } else if(strcmp(arg, "--ring") == 0 && has_value) {
+            config.ring_capacity = stoul(argv[++i]);
+        } else if(strcmp(arg, "--path") == 0 && has_value) {
+            path = argv[++i];
+        } else if(strcmp(arg, "--overflow") == 0 && has_value) {
+            const string policy = argv[++i];
+            if(policy == "block") {
+                config.overflow = OverflowPolicy::BLOCK;
+            } else if(policy == "drop-oldest") {
+                config.overflow = OverflowPolicy::DROP_OLDEST;
+            } else {
+                cerr << "Unknown overflow policy " << policy << "\n";
+                return 1;
+            }
+        } else if(strcmp(arg, "--executor-threads") == 0 && has_value) {
+            config.executor_threads = static_cast<uint32_t>(stoul(argv[++i]));
+        } else if(strcmp(arg, "--stall-prob") == 0 && has_value) {
+            config.stall_probability = stof(argv[++i]);
+        } else if(strcmp(arg, "--max-stall-us") == 0 && has_value) {
+            config.max_stall_us = static_cast<uint32_t>(stoul(argv[++i]));
+        } else if(strcmp(arg, "--early-shutdown") == 0 && has_value) {
+            config.early_shutdown_probability = stof(argv[++i]);
+        } else if(strcmp(arg, "--duration") == 0 && has_value) {
+            duration_s = stod(argv[++i]);
+        } else if(strcmp(arg, "--rounds") == 0 && has_value) {
+            max_rounds = static_cast<uint32_t>(stoul(argv[++i]));
+        } else if(strcmp(arg, "--seed") == 0 && has_value) {
+            config.seed = static_cast<uint32_t>(stoul(argv[++i]));
+        } else if(strcmp(arg, "--min-throughput") == 0 && has_value) {
+            config.min_frames_per_s = stod(argv[++i]);
+        } else if(strcmp(arg, "--max-p99-us") == 0 && has_value) {
+            config.max_p99_us = stod(argv[++i]);
+        } else {
+            cerr << "Unknown or incomplete option: " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    vector<SoakPath> paths;
+    if(path == "blocking" || path == "both") paths.push_back(SoakPath::BLOCKING);
+    if(path == "async" || path == "both") paths.push_back(SoakPath::ASYNC);
+    if(paths.empty()) {
+        cerr << "Unknown path " << path << " (expected blocking, async or both)\n";
+        return 1;
+    }
+    if(config.producers == 0 || config.consumers == 0 || config.ring_capacity < 2 || config.executor_threads == 0) {
+        cerr << "Need at least one producer, consumer and executor thread, and a ring of 2 or more\n";
+        return 1;
+    }
+
+    string error;
+    const shared_ptr<const ProfileTable> profiles = SeasonData::load(profiles_path, error);
+    if(!profiles) {
+        cerr << "Cannot load profiles: " << error << "\n";
+        return 1;
+    }
+    const TrackProfile* track = profiles->findTrack(track_id);
+    if(!track) {
+        cerr << "Unknown track id " << track_id << "\n";
+        return 1;
+    }
+    config.track = *track;
+
+    cout << "Soaking " << config.producers << " producers x " << config.consumers << " consumers, "
+         << config.laps << " laps per round, ring " << config.ring_capacity << "\n";
+
+    SoakHarness harness(config, profiles);
+    const auto start = chrono::steady_clock::now();
+    auto elapsed = [&start]() { return chrono::duration<double>(chrono::steady_clock::now() - start).count(); };
+
+    uint32_t rounds = 0;
+    uint32_t failed = 0;
+    uint64_t frames = 0;
+    while(max_rounds != 0 ? rounds < max_rounds : elapsed() < duration_s) {
+        const SoakPath round_path = paths[rounds % paths.size()];
+        const SoakRoundResult r = harness.runRound(rounds, round_path);
+        frames += r.consumed;
+
+        cout << "round " << setw(4) << rounds << "  " << setw(8) << (round_path == SoakPath::BLOCKING ? "blocking" : "async")
+             << (r.shut_down_early ? "  early-stop" : "            ")
+             << "  frames " << setw(8) << r.consumed;
+        if(r.evicted != 0) cout << " (" << r.evicted << " evicted)";
+        cout << fixed << setprecision(2)
+             << "  " << setw(6) << r.frames_per_s / 1e6 << " Mframes/s"
+             << "  p99 " << setw(8) << r.p99_us << " us"
+             << "  penalties " << r.penalties_served << "/" << r.penalties_issued << " served"
+             << defaultfloat << "  " << (r.passed() ? "ok" : "FAILED") << "\n";
+        for(const auto& failure : r.failures) {
+            cout << "    " << failure << "\n";
+        }
+
+        if(!r.passed()) failed++;
+        rounds++;
+    }
+
+    cout << "\n" << rounds << " rounds, " << frames << " frames in " << fixed << setprecision(1) << elapsed() << " s: ";
+    if(failed != 0) {
+        cout << failed << " failed\n";
+        return 1;
+    }
+    cout << "all passed\n";
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include "FieldSimulator.h"
+#include <algorithm>
+
+using namespace std;
+
+// Limits pace to the car ahead's, plus the share of the difference the track lets
+// through. A negative ahead_speed means there is no car close ahead.
+struct FieldSimulator::FollowTraffic {
+    float ahead_speed;
+    float pass_factor;
+
+    float limit(uint32_t, float speed) {
+        if(ahead_speed < 0.0f || speed <= ahead_speed) return speed;
+        return ahead_speed + (speed - ahead_speed) * pass_factor;
+    }
+};
+
+// Keeps each car's speed this tick for the cars following it.
+struct FieldSimulator::PaceTrace {
+    vector<float>& speed;
+
+    void emit(uint32_t driver_id, DriverState&, float kph, bool, uint64_t) {
+        speed[driver_id] = kph;
+    }
+};
+
+FieldSimulator::FieldSimulator(
+    const TrackProfile& track,
+    shared_ptr<const ProfileTable> profiles,
+    uint32_t total_laps
+) : track_(track), constants_(SimKernel::TrackConstants::of(track)), profiles_(std::move(profiles)), drivers_(profiles_->drivers()), cars_(profiles_->cars()), total_laps_(total_laps),
+    pass_factor_(1.0f - track.overtaking_difficulty), tick_(0) {
+    if(track_.sectors == 3 && SectorKernel::canSpecialize(constants_.sector_length_km)) {
+        run_kernel_ = &FieldSimulator::run<3>;
+    } else {
+        run_kernel_ = &FieldSimulator::run<SectorKernel::DYNAMIC>;
+    }
+
+    const size_t n = drivers_.size();
+    states_.resize(n);
+    order_.resize(n);
+    finish_tick_.resize(n);
+    distance_.resize(n);
+    speed_.resize(n);
+}
+
+void FieldSimulator::reset() {
+    tick_ = 0;
+    for(uint32_t i = 0; i < states_.size(); i++) {
+        auto& s = states_[i];
+        s.lap = 0;
+        s.sector = 1;
+        s.tire_wear = 0.0f;
+        s.distance_in_lap = 0.0f;
+        for(float& t : s.tire_temp_c) t = 70.0f;
+        s.is_on_pit = false;
+        s.has_pitted = false;
+        s.pit_stop_start_time_ns = 0;
+        s.pit_stop_end_time_ns = 0;
+        order_[i] = i;
+        finish_tick_[i] = 0;
+        distance_[i] = 0.0f;
+    }
+}
+
+void FieldSimulator::simulate(span<const uint32_t> plans, span<float> finish_times, vector<Snapshot>* trace) {
+    reset();
+    (this->*run_kernel_)(plans, trace, 0);
+    finishTimes(finish_times);
+}
+
+void FieldSimulator::resume(const Snapshot& from, span<const uint32_t> plans, span<float> finish_times) {
+    tick_ = from.tick;
+    copy(from.states.begin(), from.states.end(), states_.begin());
+    copy(from.order.begin(), from.order.end(), order_.begin());
+    copy(from.finish_tick.begin(), from.finish_tick.end(), finish_tick_.begin());
+    for(uint32_t i = 0; i < states_.size(); i++) {
+        const auto& s = states_[i];
+        distance_[i] = s.lap * track_.lap_length_km + (static_cast<float>(s.sector) - 1.0f) * constants_.sector_length_km + s.distance_in_lap;
+    }
+    (this->*run_kernel_)(plans, nullptr, 0);
+    finishTimes(finish_times);
+}
+
+const FieldSimulator::Snapshot* FieldSimulator::lastBefore(const vector<Snapshot>& trace, uint32_t driver_id, uint32_t lap) {
+    // Laps only grow along a trace, so the snapshots before `lap` are a prefix.
+    const auto first_at = partition_point(trace.begin(), trace.end(), [driver_id, lap](const Snapshot& s) {
+        return s.states[driver_id].lap < lap;
+    });
+    return first_at == trace.begin() ? nullptr : &*(first_at - 1);
+}
+
+template<uint8_t SECTORS>
+void FieldSimulator::run(span<const uint32_t> plans, vector<Snapshot>* trace, size_t trace_used) {
+    const size_t n = states_.size();
+    // Cars that cannot finish (no engine power) end the race once the rest of the
+    // field has had three more race distances.
+    uint32_t first_finish = 0;
+    for(uint32_t t : finish_tick_) {
+        if(t != 0 && (first_finish == 0 || t < first_finish)) first_finish = t;
+    }
+    size_t finished = static_cast<size_t>(count_if(finish_tick_.begin(), finish_tick_.end(), [](uint32_t t) { return t != 0; }));
+
+    SimKernel::NoPenalties penalties;
+    PaceTrace pace{speed_};
+
+    while(finished < n && (first_finish == 0 || tick_ < 4 * first_finish)) {
+        if(trace && tick_ % SNAPSHOT_TICKS == 0) {
+            record(*trace, trace_used++);
+        }
+        tick_++;
+        const uint64_t now_ns = tick_ * SimKernel::TICK_NS;
+
+        // Leader first, so every car sees the speed of the car ahead this tick.
+        for(size_t k = 0; k < n; k++) {
+            const uint32_t i = order_[k];
+            auto& state = states_[i];
+            if(finish_tick_[i] != 0) {
+                speed_[i] = 0.0f;
+                continue;
+            }
+
+            const bool should_pit = SimKernel::shouldPit<SimKernel::TimedPit>(state, drivers_[i], plans[i]);
+
+            // Cars in the pit lane or already finished do not hold anyone up.
+            FollowTraffic traffic{-1.0f, pass_factor_};
+            if(k > 0) {
+                const uint32_t ahead = order_[k - 1];
+                if(!states_[ahead].is_on_pit && finish_tick_[ahead] == 0 && distance_[ahead] - distance_[i] < TRAFFIC_GAP_KM) {
+                    traffic.ahead_speed = speed_[ahead];
+                }
+            }
+
+            SimKernel::tick<SimKernel::TimedPit, SECTORS>(constants_, i, drivers_[i], cars_[i], state, should_pit, now_ns, penalties, pace, traffic);
+
+            if(state.lap >= total_laps_) {
+                finish_tick_[i] = tick_;
+                finished++;
+                if(first_finish == 0) first_finish = tick_;
+            }
+        }
+        refreshOrder();
+    }
+
+    if(trace) trace->resize(trace_used);
+}
+
+void FieldSimulator::refreshOrder() {
+    for(uint32_t i = 0; i < states_.size(); i++) {
+        const auto& s = states_[i];
+        distance_[i] = s.lap * track_.lap_length_km + (static_cast<float>(s.sector) - 1.0f) * constants_.sector_length_km + s.distance_in_lap;
+    }
+    // Finished cars stay ahead in the order they took the flag; the rest by distance,
+    // lower id on ties. Insertion sort, as the order barely changes between ticks.
+    const auto ahead = [this](uint32_t a, uint32_t b) {
+        const uint32_t fa = finish_tick_[a], fb = finish_tick_[b];
+        if(fa != 0 || fb != 0) {
+            if(fa == 0 || fb == 0) return fa != 0;
+            return fa < fb || (fa == fb && a < b);
+        }
+        return distance_[a] > distance_[b] || (distance_[a] == distance_[b] && a < b);
+    };
+    for(size_t k = 1; k < order_.size(); k++) {
+        const uint32_t id = order_[k];
+        size_t j = k;
+        while(j > 0 && ahead(id, order_[j - 1])) {
+            order_[j] = order_[j - 1];
+            j--;
+        }
+        order_[j] = id;
+    }
+}
+
+void FieldSimulator::record(vector<Snapshot>& trace, size_t index) const {
+    if(index == trace.size()) trace.emplace_back();
+    auto& s = trace[index];
+    s.tick = tick_;
+    s.states.assign(states_.begin(), states_.end());
+    s.order.assign(order_.begin(), order_.end());
+    s.finish_tick.assign(finish_tick_.begin(), finish_tick_.end());
+}
+
+void FieldSimulator::finishTimes(span<float> finish_times) const {
+    for(size_t i = 0; i < finish_tick_.size(); i++) {
+        const uint32_t ticks = finish_tick_[i] != 0 ? finish_tick_[i] : tick_;
+        finish_times[i] = static_cast<float>(ticks) * SimKernel::TICK_SECONDS;
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../common/types.h"
+#include "../common/SimKernel.h"
+#include "../data/ProfileTable.h"
+#include <vector>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+// Whole-field race for joint strategy search. Unlike RaceSimulator, cars interact:
+// stops hold the car in the pit lane as in the live race, so a stop costs track
+// position, and a faster car that closes on the car ahead only gains on it at
+// (1 - overtaking_difficulty) of its pace advantage. Each car's finish time
+// therefore depends on every other car's plan.
+//
+// A race can record snapshots along the way and later races that only differ after
+// a snapshot resume from it instead of starting from the grid.
+class FieldSimulator {
+public:
+    // Plan entry for a car that stops on the wear-based rule.
+    static constexpr uint32_t NO_PLAN = SimKernel::NO_PLAN;
+    // Ticks between recorded snapshots.
+    static constexpr uint32_t SNAPSHOT_TICKS = 16;
+
+    // Race state at a tick boundary.
+    struct Snapshot {
+        uint32_t tick;
+        std::vector<DriverState> states;
+        std::vector<uint32_t> order;
+        std::vector<uint32_t> finish_tick;
+    };
+
+    FieldSimulator(const TrackProfile& track, std::shared_ptr<const ProfileTable> profiles, uint32_t total_laps);
+
+    // Races the field with `plans[i]` as car i's single planned pit lap (NO_PLAN for
+    // wear-based stops) and writes every car's finish time in seconds. With `trace`,
+    // a snapshot is kept every SNAPSHOT_TICKS; existing entries are overwritten in
+    // place, so a reused trace does not reallocate.
+    void simulate(std::span<const uint32_t> plans, std::span<float> finish_times, std::vector<Snapshot>* trace = nullptr);
+
+    // Continues a race from `from`. Valid when `plans` only differ from the plans
+    // that produced the snapshot in ways that had not taken effect yet.
+    void resume(const Snapshot& from, std::span<const uint32_t> plans, std::span<float> finish_times);
+
+    // Latest snapshot taken before `driver_id` reached `lap`, or nullptr.
+    static const Snapshot* lastBefore(const std::vector<Snapshot>& trace, uint32_t driver_id, uint32_t lap);
+
+    size_t driverCount() const { return states_.size(); }
+
+private:
+    // Cars closer than this behind the car ahead are held up by it (about one
+    // tick of travel at race pace).
+    static constexpr float TRAFFIC_GAP_KM = 0.15f;
+
+    struct FollowTraffic;
+    struct PaceTrace;
+
+    TrackProfile track_;
+    SimKernel::TrackConstants constants_;
+    // Shared, immutable profiles; the spans view into them.
+    std::shared_ptr<const ProfileTable> profiles_;
+    std::span<const DriverProfile> drivers_;
+    std::span<const CarProfile> cars_;
+    uint32_t total_laps_;
+    float pass_factor_;
+
+    uint32_t tick_;
+    std::vector<DriverState> states_;
+    std::vector<uint32_t> order_;        // running order, leader first
+    std::vector<uint32_t> finish_tick_;  // 0 until the car takes the flag
+    std::vector<float> distance_;
+    std::vector<float> speed_;           // this tick's speed, for the cars behind
+
+    // Race loop, specialized on sector count (SectorKernel::DYNAMIC = any).
+    using RunKernel = void (FieldSimulator::*)(std::span<const uint32_t>, std::vector<Snapshot>*, size_t);
+    RunKernel run_kernel_;
+
+    template<uint8_t SECTORS>
+    void run(std::span<const uint32_t> plans, std::vector<Snapshot>* trace, size_t trace_used);
+    void reset();
+    void record(std::vector<Snapshot>& trace, size_t index) const;
+    void refreshOrder();
+    void finishTimes(std::span<float> finish_times) const;
+};
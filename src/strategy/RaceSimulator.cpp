@@ -4,11 +4,20 @@ using namespace std;
 
 RaceSimulator::RaceSimulator(
     const TrackProfile& track, 
-    const vector<DriverProfile>& drivers, 
-    const vector<CarProfile>& cars, 
-    uint32_t total_laps
-) : track_(track), drivers_(drivers), cars_(cars), total_laps_(total_laps) {
-    states_.resize(drivers.size());
+    shared_ptr<const ProfileTable> profiles,
+    uint32_t total_laps,
+    shared_ptr<StintCache> stint_cache
+) : track_(track), constants_(SimKernel::TrackConstants::of(track)), profiles_(std::move(profiles)), drivers_(profiles_->drivers()), cars_(profiles_->cars()), total_laps_(total_laps), stint_cache_(std::move(stint_cache)) {
+    if(track_.sectors == 3 && SectorKernel::canSpecialize(constants_.sector_length_km)) {
+        tick_kernel_ = &RaceSimulator::simulateTick<3>;
+        lap_kernel_ = &RaceSimulator::runLap<3>;
+    } else {
+        tick_kernel_ = &RaceSimulator::simulateTick<SectorKernel::DYNAMIC>;
+        lap_kernel_ = &RaceSimulator::runLap<SectorKernel::DYNAMIC>;
+    }
+    track_key_ = StintCache::trackKey(track_);
+
+    states_.resize(drivers_.size());
     for(auto &s : states_) {
         s.lap = 0;
         s.sector = 1;
@@ -19,75 +28,34 @@ RaceSimulator::RaceSimulator(
     }
 }
 
-bool RaceSimulator::shouldPit(uint32_t driver_id, uint32_t target_driver_id, uint32_t forced_pit_lap) {
-    const auto &driver = drivers_[driver_id];
-    const auto &state = states_[driver_id];
-
-    if(driver_id == target_driver_id) {
-        return state.lap == forced_pit_lap && !state.has_pitted;
-    } else {
-        float base_threshold = 0.65f + (driver.tire_management * 0.25f);
-        float risk_adjustment = (driver.risk_tolerance - 0.5f) * 0.15f;
-        float pit_threshold = base_threshold + risk_adjustment;
-        
-        return state.tire_wear > pit_threshold && !state.has_pitted;
-    }
-}
-
+template<uint8_t SECTORS>
 void RaceSimulator::updateDriverState(uint32_t driver_id, uint32_t target_driver_id, uint32_t forced_pit_lap) {
-    constexpr float tick_seconds = 0.02f;
-
     auto &state = states_[driver_id];
-    const auto &driver = drivers_[driver_id];
-    const auto &car = cars_[driver_id];
-
-    if (shouldPit(driver_id, target_driver_id, forced_pit_lap)) {
-        state.has_pitted = true;
-        // Instant pit stop in strategy sim - add time penalty but don't stay in pit
-        state.total_time_seconds += (2.0f + (1.0f - car.reliability) * 1.0f);
-        state.tire_wear = 0.0f;
-        return;
-    }
-
-    // Calculate speed based on driver skill, car performance, and tire wear
-    float driver_skill = 0.80f + driver.consistency * 0.25f;
-    float speed = 220.0f * car.engine_power * driver_skill * (1.0f - state.tire_wear * 0.4f);
-
-    // Update distance and lap/sector progression
-    // distance in km; speed is km/h and tick is 20ms
-    // simulation runs ~120x faster than real time for reasonable race duration
-    constexpr float sim_speed_multiplier = 120.0f;
-    const float delta_distance_km = speed * (tick_seconds / 3600.0f) * sim_speed_multiplier;
-
-    // Tire wear scales with distance traveled (not per tick), matching TelemetryGenerator.
-    const float wear_per_lap = 0.05f * driver.aggression * track_.tire_wear_factor;
-    state.tire_wear += (delta_distance_km / track_.lap_length_km) * wear_per_lap;
-    if (state.tire_wear > 1.0f) state.tire_wear = 1.0f;
-
-    state.distance_in_lap += delta_distance_km;
-
-    float sector_length = track_.lap_length_km / track_.sectors;
-
-    while (state.distance_in_lap >= sector_length) {
-        state.distance_in_lap -= sector_length;
-        state.sector++;
-
-        if (state.sector > track_.sectors) {
-            state.sector = 1;
-            state.lap++;
-        }
+    SimKernel::NoPenalties penalties;
+    SimKernel::NoFrames frames;
+    SimKernel::NoTraffic traffic;
+
+    // Instant pit stop in strategy sim: the stop's time replaces this tick. The
+    // target stops on its candidate lap, the rest of the field as in the live race.
+    const uint32_t planned_lap = (driver_id == target_driver_id) ? forced_pit_lap : SimKernel::NO_PLAN;
+    const bool pit = SimKernel::shouldPit<SimKernel::InstantPit>(state, drivers_[driver_id], planned_lap);
+    if(SimKernel::tick<SimKernel::InstantPit, SECTORS>(constants_, driver_id, drivers_[driver_id], cars_[driver_id], state, pit, 0, penalties, frames, traffic)) {
+        state.total_time_seconds += SimKernel::TICK_SECONDS;
     }
+}
 
-    state.total_time_seconds += tick_seconds;
-} 
-
+template<uint8_t SECTORS>
 void RaceSimulator::simulateTick(uint32_t target_driver_id, uint32_t pit_lap) {
     for(uint32_t i = 0; i < drivers_.size(); i++) {
-        updateDriverState(i, target_driver_id, pit_lap);
+        updateDriverState<SECTORS>(i, target_driver_id, pit_lap);
     }
 }
 
 float RaceSimulator::simulateRace(uint32_t target_driver_id, uint32_t pit_lap) {
+    if(stint_cache_) {
+        return composeRace(target_driver_id, pit_lap);
+    }
+
     for(auto &s : states_){
         s.lap = 0;
         s.sector = 1;
@@ -98,8 +66,52 @@ float RaceSimulator::simulateRace(uint32_t target_driver_id, uint32_t pit_lap) {
     }
 
     while(states_[target_driver_id].lap < total_laps_) {
-        simulateTick(target_driver_id, pit_lap);
+        (this->*tick_kernel_)(target_driver_id, pit_lap);
     }
 
     return states_[target_driver_id].total_time_seconds;
-}
\ No newline at end of file
+}
+
+float RaceSimulator::composeRace(uint32_t driver_id, uint32_t pit_lap) {
+    constexpr float tick_seconds = SimKernel::TICK_SECONDS;
+
+    if(pit_lap >= total_laps_) {
+        return static_cast<float>(stint(driver_id, 0, total_laps_, 0.0f).ticks) * tick_seconds;
+    }
+
+    const StintResult first = stint(driver_id, 0, pit_lap, 0.0f);
+    const StintResult second = stint(driver_id, pit_lap, total_laps_ - pit_lap, 0.0f);
+    return static_cast<float>(first.ticks + second.ticks) * tick_seconds + SimKernel::pitStopSeconds(cars_[driver_id]);
+}
+
+StintResult RaceSimulator::stint(uint32_t driver_id, uint32_t start_lap, uint32_t laps, float start_wear) {
+    StintKey key{driver_id, profiles_->generation(), track_key_, static_cast<uint16_t>(start_lap), static_cast<uint16_t>(laps), StintCache::quantizeWear(start_wear)};
+    StintResult result{0, StintCache::wearOf(key.start_wear), 0.0f};
+    if(laps == 0) return result;
+
+    // Extend the longest cached prefix a lap at a time, caching every prefix so that
+    // shorter and longer stints from the same start reuse this one.
+    uint32_t done = stint_cache_->lookup(key, result);
+    while(done < laps) {
+        (this->*lap_kernel_)(driver_id, result);
+        key.stint_length = static_cast<uint16_t>(++done);
+        stint_cache_->insert(key, result);
+    }
+    return result;
+}
+
+template<uint8_t SECTORS>
+void RaceSimulator::runLap(uint32_t driver_id, StintResult& state) const {
+    SimKernel::NoPenalties penalties;
+    SimKernel::NoFrames frames;
+    SimKernel::NoTraffic traffic;
+
+    // The same kernel as updateDriverState(), for one car that never stops.
+    DriverSimState car{0, 1, state.end_wear, state.end_distance, 0.0f, false};
+    while(car.lap == 0) {
+        SimKernel::tick<SimKernel::InstantPit, SECTORS>(constants_, driver_id, drivers_[driver_id], cars_[driver_id], car, false, 0, penalties, frames, traffic);
+        state.ticks++;
+    }
+    state.end_wear = car.tire_wear;
+    state.end_distance = car.distance_in_lap;
+}
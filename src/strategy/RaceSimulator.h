@@ -1,19 +1,28 @@
 #pragma once
 
 #include "../common/types.h"
+#include "../common/SimKernel.h"
+#include "StintCache.h"
+#include "../data/ProfileTable.h"
 #include <vector>
 #include <cstdint>
 #include <map>
+#include <memory>
+#include <span>
 
 class RaceSimulator {
 public:
     RaceSimulator(
         const TrackProfile& track, 
-        const std::vector<DriverProfile>& drivers, 
-        const std::vector<CarProfile>& cars, 
-        uint32_t total_laps
+        std::shared_ptr<const ProfileTable> profiles,
+        uint32_t total_laps,
+        std::shared_ptr<StintCache> stint_cache = nullptr
     );
 
+    // Race time of the target driver with one stop on `pit_lap` (none if it is past
+    // the flag). The target does not interact with the rest of the field, so with a
+    // stint cache the race is composed from two cached stints instead of simulated
+    // tick by tick; stints then start from the lap line and times are whole ticks.
     float simulateRace(uint32_t target_driver_id, uint32_t pit_lap);
 
 private:
@@ -27,13 +36,33 @@ private:
     };
 
     TrackProfile track_;
-    std::vector<DriverProfile> drivers_;
-    std::vector<CarProfile> cars_;
+    SimKernel::TrackConstants constants_;
+    // Shared, immutable profiles; the spans view into them.
+    std::shared_ptr<const ProfileTable> profiles_;
+    std::span<const DriverProfile> drivers_;
+    std::span<const CarProfile> cars_;
     uint32_t total_laps_;
 
     std::vector<DriverSimState> states_;
+    std::shared_ptr<StintCache> stint_cache_;
 
+    // Tick kernel, specialized on sector count (SectorKernel::DYNAMIC = any). Cars run
+    // SimKernel with instant stops and no penalties or frames.
+    using TickKernel = void (RaceSimulator::*)(uint32_t, uint32_t);
+    TickKernel tick_kernel_;
+    // The same specialization for composed races, one flying lap at a time.
+    using LapKernel = void (RaceSimulator::*)(uint32_t, StintResult&) const;
+    LapKernel lap_kernel_;
+    uint32_t track_key_;   // StintCache::trackKey(track_)
+
+    template<uint8_t SECTORS>
     void simulateTick(uint32_t target_driver_id, uint32_t pit_lap);
+    template<uint8_t SECTORS>
     void updateDriverState(uint32_t driver_id, uint32_t target_driver_id, uint32_t forced_pit_lap);
-    bool shouldPit(uint32_t driver_id, uint32_t target_driver_id, uint32_t forced_pit_lap);
+
+    float composeRace(uint32_t driver_id, uint32_t pit_lap);
+    StintResult stint(uint32_t driver_id, uint32_t start_lap, uint32_t laps, float start_wear);
+    // Advances `state` by one flying lap of `driver_id` with no stop.
+    template<uint8_t SECTORS>
+    void runLap(uint32_t driver_id, StintResult& state) const;
 };
@@ -0,0 +1,136 @@
+#include "StintCache.h"
+#include "../monitoring/MetricsRegistry.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+
+uint64_t mix(uint64_t x) {
+    // splitmix64 finalizer
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+} // namespace
+
+StintCache::StintCache(size_t capacity)
+    : sets_per_stripe_(max<size_t>(1, (capacity + STRIPES * WAYS - 1) / (STRIPES * WAYS))) {
+    for(auto& stripe : stripes_) {
+        stripe.sets.resize(sets_per_stripe_, Set{{}, 0});
+        stripe.origins.resize(sets_per_stripe_, Origin{{}, 0, false});
+    }
+}
+
+uint64_t StintCache::originHash(const StintKey& key) {
+    const uint64_t packed = (static_cast<uint64_t>(key.driver_id) << 32)
+                          | (static_cast<uint64_t>(key.start_lap) << 16)
+                          | key.start_wear;
+    return mix(packed ^ mix((static_cast<uint64_t>(key.profiles) << 32) | key.track));
+}
+
+uint64_t StintCache::hash(const StintKey& key) {
+    return mix(originHash(key) ^ key.stint_length);
+}
+
+bool StintCache::probe(const Set& set, const StintKey& key, StintResult& out) {
+    for(const Slot& slot : set.ways) {
+        if(slot.used && slot.key == key) {
+            out = slot.value;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t StintCache::lookup(const StintKey& key, StintResult& out) const {
+    const uint64_t origin_hash = originHash(key);
+    const Stripe& stripe = stripes_[origin_hash % STRIPES];
+    StintKey prefix = key;
+    prefix.stint_length = 0;
+
+    uint32_t found = 0;
+    {
+        lock_guard<mutex> lock(stripe.mutex);
+        const Origin& origin = stripe.origins[(origin_hash / STRIPES) % sets_per_stripe_];
+        if(origin.used && origin.key == prefix) {
+            // Shorter prefixes may have been evicted since, so walk down from the longest.
+            for(uint32_t laps = min<uint32_t>(key.stint_length, origin.longest); laps > 0 && found == 0; laps--) {
+                prefix.stint_length = static_cast<uint16_t>(laps);
+                if(probe(stripe.sets[(hash(prefix) / STRIPES) % sets_per_stripe_], prefix, out)) found = laps;
+            }
+        }
+        if(found == key.stint_length) stripe.hits++;
+        else if(found > 0) stripe.prefix_hits++;
+        else stripe.misses++;
+    }
+    Metrics::increment(found > 0 ? Counter::STINT_CACHE_HITS : Counter::STINT_CACHE_MISSES);
+    return found;
+}
+
+void StintCache::insert(const StintKey& key, const StintResult& value) {
+    const uint64_t origin_hash = originHash(key);
+    Stripe& stripe = stripes_[origin_hash % STRIPES];
+    Set& set = stripe.sets[(hash(key) / STRIPES) % sets_per_stripe_];
+    StintKey start = key;
+    start.stint_length = 0;
+
+    lock_guard<mutex> lock(stripe.mutex);
+    Origin& origin = stripe.origins[(origin_hash / STRIPES) % sets_per_stripe_];
+    if(origin.used && origin.key == start) {
+        origin.longest = max(origin.longest, key.stint_length);
+    } else {
+        origin = Origin{start, key.stint_length, true};
+    }
+
+    Slot* target = nullptr;
+    for(Slot& slot : set.ways) {
+        if(slot.used && slot.key == key) {
+            // Another worker got there first; the value is the same.
+            return;
+        }
+        if(!slot.used && !target) target = &slot;
+    }
+    if(!target) {
+        target = &set.ways[set.next_victim];
+        set.next_victim = static_cast<uint8_t>((set.next_victim + 1) % WAYS);
+        stripe.evictions++;
+    }
+    *target = Slot{key, value, true};
+    stripe.inserts++;
+}
+
+StintCache::Stats StintCache::stats() const {
+    Stats s{0, 0, 0, 0, 0};
+    for(const auto& stripe : stripes_) {
+        lock_guard<mutex> lock(stripe.mutex);
+        s.hits += stripe.hits;
+        s.prefix_hits += stripe.prefix_hits;
+        s.misses += stripe.misses;
+        s.inserts += stripe.inserts;
+        s.evictions += stripe.evictions;
+    }
+    return s;
+}
+
+uint16_t StintCache::quantizeWear(float wear) {
+    return static_cast<uint16_t>(lround(clamp(wear, 0.0f, 1.0f) * 1000.0f));
+}
+
+float StintCache::wearOf(uint16_t quantized) {
+    return static_cast<float>(quantized) * 0.001f;
+}
+
+uint32_t StintCache::trackKey(const TrackProfile& track) {
+    uint64_t h = mix(track.track_id);
+    h = mix(h ^ bit_cast<uint32_t>(track.lap_length_km));
+    h = mix(h ^ bit_cast<uint32_t>(track.tire_wear_factor));
+    h = mix(h ^ track.sectors);
+    return static_cast<uint32_t>(h ^ (h >> 32));
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "../common/types.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// One stint: a driver leaving the lap line on `start_lap` with tires at `start_wear`
+// and running `stint_length` laps without stopping, on the track identified by
+// `track` (StintCache::trackKey). driver_id indexes the ProfileTable whose
+// generation() is `profiles`. start_wear is the tire state (compound/wear) in
+// thousandths.
+struct StintKey {
+    uint32_t driver_id;
+    uint32_t profiles;
+    uint32_t track;
+    uint16_t start_lap;
+    uint16_t stint_length;
+    uint16_t start_wear;
+
+    bool operator==(const StintKey& other) const {
+        return driver_id == other.driver_id && profiles == other.profiles && track == other.track
+            && start_lap == other.start_lap && stint_length == other.stint_length && start_wear == other.start_wear;
+    }
+};
+
+// State when the stint's last lap is completed. Times are whole simulation ticks, so
+// stints combine into a race by exact integer addition.
+struct StintResult {
+    uint32_t ticks;
+    float end_wear;
+    float end_distance;   // distance already run into the next lap's first sector (km)
+};
+
+// Concurrent memo of stint results shared by every strategy worker. The table is
+// fixed-size and split into independently locked stripes; each key maps to one
+// 4-way set and a full set evicts round-robin, so memory stays bounded however many
+// stints are simulated. Every length of a stint from one start lives in the same
+// stripe, next to a record of the longest one inserted, so a lookup takes one lock
+// and only probes lengths that can be there.
+class StintCache {
+public:
+    struct Stats {
+        uint64_t hits;          // whole stint cached
+        uint64_t prefix_hits;   // only a shorter prefix cached; the rest was simulated
+        uint64_t misses;
+        uint64_t inserts;
+        uint64_t evictions;
+
+        double hitRate() const {
+            const uint64_t lookups = hits + prefix_hits + misses;
+            return lookups == 0 ? 0.0 : static_cast<double>(hits + prefix_hits) / static_cast<double>(lookups);
+        }
+    };
+
+    // `capacity` entries, rounded up to a whole number of sets per stripe.
+    explicit StintCache(size_t capacity = 64 * 1024);
+
+    StintCache(const StintCache&) = delete;
+    StintCache& operator=(const StintCache&) = delete;
+
+    // Finds the longest cached prefix of `key` (same stint, at most key.stint_length
+    // laps) and returns its length, 0 if none.
+    uint32_t lookup(const StintKey& key, StintResult& out) const;
+    void insert(const StintKey& key, const StintResult& value);
+
+    Stats stats() const;
+    size_t capacity() const { return STRIPES * sets_per_stripe_ * WAYS; }
+
+    static uint16_t quantizeWear(float wear);
+    static float wearOf(uint16_t quantized);
+    // Track id mixed with the parameters stint times depend on, so simulators on
+    // different tracks (or edited copies of one) can share a cache.
+    static uint32_t trackKey(const TrackProfile& track);
+
+private:
+    static constexpr size_t STRIPES = 64;
+    static constexpr size_t WAYS = 4;
+
+    struct Slot {
+        StintKey key;
+        StintResult value;
+        bool used;
+    };
+
+    struct Set {
+        std::array<Slot, WAYS> ways;
+        uint8_t next_victim;
+    };
+
+    // Longest length inserted for one start (key with stint_length 0), direct-mapped.
+    struct Origin {
+        StintKey key;
+        uint16_t longest;
+        bool used;
+    };
+
+    struct alignas(64) Stripe {
+        mutable std::mutex mutex;
+        std::vector<Set> sets;
+        std::vector<Origin> origins;
+        mutable uint64_t hits = 0;
+        mutable uint64_t prefix_hits = 0;
+        mutable uint64_t misses = 0;
+        uint64_t inserts = 0;
+        uint64_t evictions = 0;
+    };
+
+    size_t sets_per_stripe_;
+    std::array<Stripe, STRIPES> stripes_;
+
+    // originHash() ignores stint_length and picks the stripe; hash() picks the set.
+    static uint64_t originHash(const StintKey& key);
+    static uint64_t hash(const StintKey& key);
+    static bool probe(const Set& set, const StintKey& key, StintResult& out);
+};
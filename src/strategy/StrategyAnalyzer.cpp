@@ -1,5 +1,11 @@
 #include "StrategyAnalyzer.h"
+#include "../monitoring/MetricsRegistry.h"
+#include "../runtime/Topology.h"
 #include <future>
+#include <atomic>
+#include <algorithm>
+#include <map>
+#include <thread>
 
 using namespace std;
 
@@ -7,10 +13,12 @@ const vector<uint32_t> StrategyAnalyzer::PIT_LAPS_TO_TEST = {12, 15, 18, 21, 24,
 
 StrategyAnalyzer::StrategyAnalyzer(
     const TrackProfile& track,
-    const vector<DriverProfile>& drivers,
-    const vector<CarProfile>& cars,
-    uint32_t total_laps
-) : track_(track), drivers_(drivers), cars_(cars), total_laps_(total_laps) {}
+    shared_ptr<const ProfileTable> profiles,
+    uint32_t total_laps,
+    uint32_t max_threads,
+    shared_ptr<StintCache> stint_cache
+) : track_(track), profiles_(std::move(profiles)), total_laps_(total_laps), max_threads_(max_threads),
+    stint_cache_(stint_cache ? std::move(stint_cache) : make_shared<StintCache>()) {}
 
 vector<StrategyResult> StrategyAnalyzer::analyzeStrategies(const std::vector<uint32_t>& driver_ids_to_optimize) {
     vector<StrategyResult> results;
@@ -24,29 +32,192 @@ vector<StrategyResult> StrategyAnalyzer::analyzeStrategies(const std::vector<uin
     return results;
 }
 
+JointStrategyResult StrategyAnalyzer::analyzeJointStrategies(const vector<uint32_t>& driver_ids_to_optimize, uint32_t max_rounds) {
+    const size_t n = profiles_->drivers().size();
+    vector<uint32_t> drivers;
+    for(uint32_t id : driver_ids_to_optimize) {
+        if(id < n && find(drivers.begin(), drivers.end(), id) == drivers.end()) drivers.push_back(id);
+    }
+
+    JointStrategyResult joint{{}, 0, false, 0};
+    vector<uint32_t> plans(n, FieldSimulator::NO_PLAN);
+    for(uint32_t id : drivers) {
+        plans[id] = findOptimalForDriver(id).optimal_pit_lap;
+    }
+
+    struct Job {
+        uint32_t driver;
+        uint32_t pit_lap;
+        size_t slot;           // index into candidate_times
+        vector<float> times;   // every car's finish time in this race
+    };
+
+    const size_t candidates = PIT_LAPS_TO_TEST.size();
+    const size_t worker_count = (max_threads_ == 0) ? max<size_t>(1, thread::hardware_concurrency()) : max_threads_;
+
+    // Kept across rounds: one simulator per worker, the baseline race's snapshots
+    // (candidates resume from the last one before they diverge), the job buffers,
+    // and every plan set raced so far, so a search that cycles does not race a plan
+    // set twice.
+    vector<unique_ptr<FieldSimulator>> simulators;
+    simulators.push_back(make_unique<FieldSimulator>(track_, profiles_, total_laps_));
+    vector<FieldSimulator::Snapshot> trace;
+    vector<Job> jobs;
+    vector<float> candidate_times(drivers.size() * candidates);
+    map<vector<uint32_t>, vector<float>> raced;
+    vector<float> base(n);
+
+    while(true) {
+        if(joint.rounds == max_rounds) {
+            // Out of rounds: only the finish times of the final plans are needed.
+            if(const auto known = raced.find(plans); known != raced.end()) {
+                base = known->second;
+            } else {
+                simulators[0]->simulate(plans, base);
+                joint.races_simulated++;
+            }
+            break;
+        }
+        simulators[0]->simulate(plans, base, &trace);
+        joint.races_simulated++;
+        raced[plans] = base;
+        joint.rounds++;
+
+        // Every driver's alternatives against the others' current plans.
+        size_t job_count = 0;
+        vector<uint32_t> candidate = plans;
+        for(size_t d = 0; d < drivers.size(); d++) {
+            const uint32_t id = drivers[d];
+            for(size_t c = 0; c < candidates; c++) {
+                const uint32_t pit_lap = PIT_LAPS_TO_TEST[c];
+                if(pit_lap == plans[id]) continue;
+                candidate[id] = pit_lap;
+                if(const auto known = raced.find(candidate); known != raced.end()) {
+                    candidate_times[d * candidates + c] = known->second[id];
+                } else {
+                    if(job_count == jobs.size()) jobs.emplace_back();
+                    auto& job = jobs[job_count++];
+                    job.driver = id;
+                    job.pit_lap = pit_lap;
+                    job.slot = d * candidates + c;
+                    job.times.resize(n);
+                }
+            }
+            candidate[id] = plans[id];
+        }
+
+        while(simulators.size() < min(worker_count, job_count)) {
+            simulators.push_back(make_unique<FieldSimulator>(track_, profiles_, total_laps_));
+        }
+        atomic<size_t> next_job(0);
+        vector<future<void>> futures;
+        for(size_t w = 0; w < min(worker_count, job_count); w++) {
+            futures.push_back(
+                async(launch::async, [&, w](){
+                    if(!worker_cpus_.empty()) {
+                        Topology::pinCurrentThread(worker_cpus_[w % worker_cpus_.size()]);
+                    }
+                    FieldSimulator& simulator = *simulators[w];
+                    vector<uint32_t> race_plans = plans;
+                    for(size_t j = next_job.fetch_add(1); j < job_count; j = next_job.fetch_add(1)) {
+                        auto& job = jobs[j];
+                        race_plans[job.driver] = job.pit_lap;
+                        // Identical to the baseline until the driver reaches the earlier of the two pit laps.
+                        const auto* from = FieldSimulator::lastBefore(trace, job.driver, min(job.pit_lap, plans[job.driver]));
+                        if(from) {
+                            simulator.resume(*from, race_plans, job.times);
+                        } else {
+                            simulator.simulate(race_plans, job.times);
+                        }
+                        race_plans[job.driver] = plans[job.driver];
+                        Metrics::increment(Counter::STRATEGY_JOBS_COMPLETED);
+                    }
+                })
+            );
+        }
+        for(auto& f : futures) {
+            f.get();
+        }
+        joint.races_simulated += job_count;
+
+        for(size_t j = 0; j < job_count; j++) {
+            const auto& job = jobs[j];
+            candidate_times[job.slot] = job.times[job.driver];
+            candidate[job.driver] = job.pit_lap;
+            raced.emplace(candidate, job.times);
+            candidate[job.driver] = plans[job.driver];
+        }
+
+        // Best responses, all against this round's plans. A switch needs a gain of at
+        // least a tick, and ties keep the earlier lap.
+        vector<uint32_t> next_plans = plans;
+        for(size_t d = 0; d < drivers.size(); d++) {
+            const uint32_t id = drivers[d];
+            float best = base[id];
+            for(size_t c = 0; c < candidates; c++) {
+                if(PIT_LAPS_TO_TEST[c] == plans[id]) continue;
+                const float time = candidate_times[d * candidates + c];
+                if(time < best - SimKernel::TICK_SECONDS * 0.5f) {
+                    best = time;
+                    next_plans[id] = PIT_LAPS_TO_TEST[c];
+                }
+            }
+        }
+        if(next_plans == plans) {
+            joint.converged = true;
+            break;
+        }
+        plans = next_plans;
+    }
+
+    for(uint32_t id : drivers) {
+        joint.results.push_back({id, plans[id], base[id]});
+    }
+    return joint;
+}
+
+void StrategyAnalyzer::setWorkerCpus(const vector<int>& cpus) {
+    worker_cpus_ = cpus;
+}
+
 StrategyResult StrategyAnalyzer::findOptimalForDriver(uint32_t driver_id) {
-    vector<future<float>> futures;
+    const size_t candidates = PIT_LAPS_TO_TEST.size();
+    const size_t worker_count = (max_threads_ == 0) ? candidates : min<size_t>(max_threads_, candidates);
+
+    vector<float> times(candidates);
+    atomic<size_t> next_candidate(0);
+    vector<future<void>> futures;
 
-    for(uint32_t i = 0; i < PIT_LAPS_TO_TEST.size(); i++) {
+    // Each worker reuses one simulator and pulls candidate pit laps until none are left.
+    // All simulators share the stint cache, so candidates reuse each other's stints.
+    for(size_t w = 0; w < worker_count; w++) {
         futures.push_back(
-            async(launch::async, [=](){
-                RaceSimulator simulator(track_, drivers_, cars_, total_laps_);
-                return simulator.simulateRace(driver_id, PIT_LAPS_TO_TEST[i]);
+            async(launch::async, [&, driver_id, w](){
+                if(!worker_cpus_.empty()) {
+                    Topology::pinCurrentThread(worker_cpus_[w % worker_cpus_.size()]);
+                }
+                RaceSimulator simulator(track_, profiles_, total_laps_, stint_cache_);
+                for(size_t i = next_candidate.fetch_add(1); i < candidates; i = next_candidate.fetch_add(1)) {
+                    times[i] = simulator.simulateRace(driver_id, PIT_LAPS_TO_TEST[i]);
+                    Metrics::increment(Counter::STRATEGY_JOBS_COMPLETED);
+                }
             })
         );
     }
 
+    for(auto& f : futures) {
+        f.get();
+    }
+
     uint32_t best_pit_lap = PIT_LAPS_TO_TEST[0];
-    float best_time = futures[0].get();
+    float best_time = times[0];
 
-    for(uint32_t i = 1; i < PIT_LAPS_TO_TEST.size(); i++) {
-        float time = futures[i].get();
-        
-        if(time < best_time) {
-            best_time = time;
+    for(uint32_t i = 1; i < candidates; i++) {
+        if(times[i] < best_time) {
+            best_time = times[i];
             best_pit_lap = PIT_LAPS_TO_TEST[i];
         }
     }
 
     return {driver_id, best_pit_lap, best_time};
-}
\ No newline at end of file
+}
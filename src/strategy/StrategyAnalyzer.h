@@ -2,9 +2,12 @@
 
 #include "../common/types.h"
 #include "RaceSimulator.h"
+#include "StintCache.h"
+#include "FieldSimulator.h"
 #include <vector>
 #include <cstdint>
 #include <string>
+#include <memory>
 
 struct StrategyResult {
     uint32_t driver_id;
@@ -12,22 +15,47 @@ struct StrategyResult {
     float finish_time_seconds;
 };
 
+// Outcome of a joint search: every optimized driver's plan and finish time under the
+// final set of plans.
+struct JointStrategyResult {
+    std::vector<StrategyResult> results;
+    uint32_t rounds;      // best-response rounds run
+    bool converged;       // false if the round limit stopped the search
+    uint64_t races_simulated;
+};
+
 class StrategyAnalyzer {
 public:
     StrategyAnalyzer(
         const TrackProfile& track,
-        const std::vector<DriverProfile>& drivers,
-        const std::vector<CarProfile>& cars,
-        uint32_t total_laps
+        std::shared_ptr<const ProfileTable> profiles,
+        uint32_t total_laps,
+        uint32_t max_threads = 0,  // 0 = one task per candidate pit lap
+        std::shared_ptr<StintCache> stint_cache = nullptr  // nullptr = a private cache
     );
 
     std::vector<StrategyResult> analyzeStrategies(const std::vector<uint32_t>& driver_ids_to_optimize);
 
+    // Optimizes the drivers together rather than one at a time against wear-based
+    // rivals. Plans start from each driver's independent optimum; then every round
+    // evaluates every driver's candidate pit laps in parallel against the others'
+    // current plans in a FieldSimulator race (with pit-lane time loss and traffic),
+    // and each driver switches to its best response. Rounds repeat until no plan
+    // changes or `max_rounds` is reached. With max_threads 0, one worker per core.
+    JointStrategyResult analyzeJointStrategies(const std::vector<uint32_t>& driver_ids_to_optimize, uint32_t max_rounds = 8);
+
+    // Worker i pins itself to cpus[i % size]; empty (the default) leaves them to the OS.
+    void setWorkerCpus(const std::vector<int>& cpus);
+
+    StintCache::Stats stintCacheStats() const { return stint_cache_->stats(); }
+
 private:
     TrackProfile track_;
-    std::vector<DriverProfile> drivers_;
-    std::vector<CarProfile> cars_;
+    std::shared_ptr<const ProfileTable> profiles_;
     uint32_t total_laps_;
+    uint32_t max_threads_;
+    std::vector<int> worker_cpus_;
+    std::shared_ptr<StintCache> stint_cache_;
 
     static const std::vector<uint32_t> PIT_LAPS_TO_TEST;
 
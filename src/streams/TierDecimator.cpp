@@ -0,0 +1,115 @@
+#include "TierDecimator.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+float seconds(uint64_t ns) {
+    return static_cast<float>(ns) * 1e-9f;
+}
+
+float average(float sum, uint32_t samples) {
+    return samples > 0 ? sum / static_cast<float>(samples) : 0.0f;
+}
+
+} // namespace
+
+TierDecimator::TierDecimator(size_t driver_count, uint8_t sectors, uint32_t rate_divisor)
+    : sectors_(max<uint8_t>(sectors, 1)),
+      rate_divisor_(max<uint32_t>(rate_divisor, 1)),
+      trackers_(driver_count, Tracker{}) {}
+
+uint8_t TierDecimator::process(const TelemetryFrame& frame, SectorEvent& sector, LapSummary& lap) {
+    uint8_t tiers = tierBit(StreamTier::FULL);
+    if(frame.driver_id >= trackers_.size()) {
+        emitted_[static_cast<size_t>(StreamTier::FULL)]++;
+        return tiers;
+    }
+
+    auto& t = trackers_[frame.driver_id];
+    const uint64_t now = frame.timestamp_ns;
+    const float speed = frame.speed_kph;
+
+    if(t.frames++ % rate_divisor_ == 0) {
+        tiers |= tierBit(StreamTier::HZ10);
+    }
+
+    if(!t.seen) {
+        // Frames are stamped at the end of a tick, so a stream that starts on lap 0,
+        // sector 1 is timed from the race start.
+        const bool at_start = (frame.lap == 0 && frame.sector == 1);
+        t.seen = true;
+        t.lap = frame.lap;
+        t.sector = frame.sector;
+        t.sector_timed = at_start;
+        t.lap_timed = at_start;
+        t.sector_start_ns = at_start ? 0 : now;
+        t.lap_start_ns = t.sector_start_ns;
+        t.lap_start_wear = frame.tire_wear;
+    } else if(frame.sector != t.sector || frame.lap != t.lap) {
+        // Only time splits across a single observed boundary.
+        const bool wraps = (t.sector >= sectors_);
+        const bool contiguous = frame.sector == (wraps ? 1 : t.sector + 1) && frame.lap == (wraps ? t.lap + 1 : t.lap);
+
+        sector = SectorEvent{};
+        sector.timestamp_ns = now;
+        sector.driver_id = frame.driver_id;
+        sector.lap = frame.lap;
+        sector.sector = frame.sector;
+        sector.car_class = frame.car_class;
+        sector.race_position = frame.race_position;
+        sector.sector_time_s = (contiguous && t.sector_timed) ? seconds(now - t.sector_start_ns) : 0.0f;
+        sector.avg_speed_kph = average(t.sector_speed_sum, t.sector_samples);
+        sector.max_speed_kph = t.sector_max_speed;
+        sector.speed_kph = speed;
+        sector.tire_wear = frame.tire_wear;
+        tiers |= tierBit(StreamTier::SECTOR);
+
+        if(frame.lap != t.lap) {
+            lap = LapSummary{};
+            lap.timestamp_ns = now;
+            lap.driver_id = frame.driver_id;
+            lap.lap = t.lap;
+            lap.car_class = frame.car_class;
+            lap.pitted = t.pitted;
+            lap.race_position = frame.race_position;
+            lap.lap_time_s = (contiguous && t.lap_timed) ? seconds(now - t.lap_start_ns) : 0.0f;
+            lap.avg_speed_kph = average(t.lap_speed_sum, t.lap_samples);
+            lap.max_speed_kph = t.lap_max_speed;
+            lap.start_wear = t.lap_start_wear;
+            lap.end_wear = frame.tire_wear;
+            tiers |= tierBit(StreamTier::LAP);
+
+            t.lap = frame.lap;
+            t.lap_timed = contiguous;
+            t.lap_start_ns = now;
+            t.lap_start_wear = frame.tire_wear;
+            t.lap_samples = 0;
+            t.lap_speed_sum = 0.0f;
+            t.lap_max_speed = 0.0f;
+            t.pitted = false;
+        }
+
+        t.sector = frame.sector;
+        t.sector_timed = contiguous;
+        t.sector_start_ns = now;
+        t.sector_samples = 0;
+        t.sector_speed_sum = 0.0f;
+        t.sector_max_speed = 0.0f;
+    }
+
+    // The crossing frame opens the new sector and lap.
+    t.sector_samples++;
+    t.sector_speed_sum += speed;
+    t.sector_max_speed = max(t.sector_max_speed, speed);
+    t.lap_samples++;
+    t.lap_speed_sum += speed;
+    t.lap_max_speed = max(t.lap_max_speed, speed);
+    if(speed == 0.0f) t.pitted = true;
+
+    for(size_t i = 0; i < STREAM_TIER_COUNT; i++) {
+        if(tiers & (1u << i)) emitted_[i]++;
+    }
+    return tiers;
+}
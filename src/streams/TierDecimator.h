@@ -0,0 +1,75 @@
+#pragma once
+
+#include "../common/types.h"
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Resolutions the raw 50 Hz stream is served at. Consumers subscribe to the tier
+// they need instead of filtering every frame themselves.
+enum class StreamTier : uint8_t {
+    FULL,       // every frame
+    HZ10,       // every 5th frame per car
+    SECTOR,     // one SectorEvent per sector line crossed
+    LAP,        // one LapSummary per lap completed
+};
+
+constexpr size_t STREAM_TIER_COUNT = 4;
+
+constexpr uint8_t tierBit(StreamTier tier) {
+    return static_cast<uint8_t>(1u << static_cast<uint8_t>(tier));
+}
+
+// Computes every tier from the raw stream in one pass. Each car keeps a fixed-size
+// tracker (last position plus running speed aggregates for the current sector and
+// lap), so no raw history is stored and a frame costs O(1).
+//
+// Boundaries are detected from frame transitions as in RaceAnalytics: a car whose
+// stream starts on lap 0, sector 1 is timed from the race start; otherwise its
+// first partial sector and lap are reported with a zero time.
+//
+// process() is meant for one thread.
+class TierDecimator {
+public:
+    // The generator ticks at 50 Hz, so every 5th frame per car is 10 Hz.
+    static constexpr uint32_t DEFAULT_RATE_DIVISOR = 5;
+
+    TierDecimator(size_t driver_count, uint8_t sectors, uint32_t rate_divisor = DEFAULT_RATE_DIVISOR);
+
+    // Folds one raw frame into the tiers and returns the tiers it produced output on
+    // (a mask of tierBit()). FULL and HZ10 output is the frame itself; the SECTOR and
+    // LAP bits mean `sector` and `lap` were filled in.
+    uint8_t process(const TelemetryFrame& frame, SectorEvent& sector, LapSummary& lap);
+
+    // Items produced on `tier` so far.
+    uint64_t emitted(StreamTier tier) const { return emitted_[static_cast<size_t>(tier)]; }
+
+private:
+    struct Tracker {
+        bool seen;
+        bool sector_timed;
+        bool lap_timed;
+        bool pitted;
+
+        uint32_t lap;
+        uint8_t sector;
+        uint32_t frames;
+
+        uint64_t sector_start_ns;
+        uint32_t sector_samples;
+        float sector_speed_sum;
+        float sector_max_speed;
+
+        uint64_t lap_start_ns;
+        uint32_t lap_samples;
+        float lap_speed_sum;
+        float lap_max_speed;
+        float lap_start_wear;
+    };
+
+    uint8_t sectors_;
+    uint32_t rate_divisor_;
+    std::vector<Tracker> trackers_;
+    std::array<uint64_t, STREAM_TIER_COUNT> emitted_{};
+};
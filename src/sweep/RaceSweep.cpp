@@ -0,0 +1,321 @@
+#include "RaceSweep.h"
+#include "../telemetry/TelemetryGenerator.h"
+#include "../race-control/TrackLimitsMonitor.h"
+#include "../race-control/PenaltyEnforcer.h"
+#include <thread>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <numeric>
+
+using namespace std;
+
+RaceSweep::RaceSweep(
+    const SweepConfig& config,
+    shared_ptr<const ProfileTable> profiles
+) : config_(config), profiles_(std::move(profiles)), next_race_(0) {
+    // Expand the matrix up front so every race has a fixed id and output slot.
+    uint32_t race_id = 0;
+    for(uint32_t t = 0; t < config_.tracks.size(); t++) {
+        for(uint32_t laps : config_.lap_counts) {
+            for(const auto& strategy : config_.strategies) {
+                for(uint32_t s = 0; s < config_.seeds_per_combination; s++) {
+                    races_.push_back({race_id, t, laps, strategy.pit_lap, config_.base_seed + race_id});
+                    race_id++;
+                }
+            }
+        }
+    }
+}
+
+size_t RaceSweep::raceCount() const {
+    return races_.size();
+}
+
+SweepResults RaceSweep::run() {
+    const size_t n_races = races_.size();
+    const size_t n_drivers = profiles_->drivers().size();
+
+    SweepResults results;
+    results.driver_count = static_cast<uint32_t>(n_drivers);
+
+    results.race_id.resize(n_races);
+    results.race_track_id.resize(n_races);
+    results.race_laps.resize(n_races);
+    results.race_strategy_pit_lap.resize(n_races);
+    results.race_seed.resize(n_races);
+    results.race_winner.resize(n_races);
+    results.race_duration_s.resize(n_races);
+
+    results.driver_race_id.resize(n_races * n_drivers);
+    results.driver_id.resize(n_races * n_drivers);
+    results.driver_finish_position.resize(n_races * n_drivers);
+    results.driver_laps_completed.resize(n_races * n_drivers);
+    results.driver_finish_time_s.resize(n_races * n_drivers);
+    results.driver_pit_count.resize(n_races * n_drivers);
+    results.driver_warnings.resize(n_races * n_drivers);
+    results.driver_penalized.resize(n_races * n_drivers);
+
+    uint32_t thread_count = config_.threads;
+    if(thread_count == 0) {
+        thread_count = max(1u, thread::hardware_concurrency());
+    }
+    thread_count = static_cast<uint32_t>(min<size_t>(thread_count, max<size_t>(n_races, 1)));
+
+    next_race_.store(0);
+
+    // Workers write race/driver rows straight into their preassigned slots; only the
+    // variable-length pit table is collected per worker and merged afterwards.
+    vector<vector<PitRecord>> worker_pits(thread_count);
+    vector<thread> workers;
+    for(uint32_t w = 0; w < thread_count; w++) {
+        workers.emplace_back([this, &results, &worker_pits, w]() {
+            runWorker(results, worker_pits[w]);
+        });
+    }
+    for(auto& worker : workers) {
+        worker.join();
+    }
+
+    vector<PitRecord> pits;
+    for(auto& wp : worker_pits) {
+        pits.insert(pits.end(), wp.begin(), wp.end());
+    }
+    // Each race runs on exactly one worker, so a stable sort keeps per-race order.
+    stable_sort(pits.begin(), pits.end(), [](const PitRecord& a, const PitRecord& b) {
+        return a.race_id < b.race_id;
+    });
+
+    results.pit_race_id.reserve(pits.size());
+    results.pit_driver_id.reserve(pits.size());
+    results.pit_lap.reserve(pits.size());
+    for(const auto& p : pits) {
+        results.pit_race_id.push_back(p.race_id);
+        results.pit_driver_id.push_back(p.driver_id);
+        results.pit_lap.push_back(p.lap);
+    }
+
+    return results;
+}
+
+struct RaceSweep::TrackRig {
+    shared_ptr<PenaltyEnforcer> penalty_enforcer;
+    TelemetryGenerator generator;
+    TrackLimitsMonitor track_limits_monitor;
+
+    TrackRig(const TrackProfile& track, const shared_ptr<const ProfileTable>& profiles, shared_ptr<PenaltyEnforcer> penalties)
+        : penalty_enforcer(std::move(penalties)),
+          generator(track, profiles, 0, penalty_enforcer),
+          track_limits_monitor(track, profiles, penalty_enforcer, 0) {}
+};
+
+struct RaceSweep::Worker {
+    vector<unique_ptr<TrackRig>> rigs;   // by track index
+    // Every driver always has an entry (NO_PLAN for wear-based), so reassigning it
+    // to the generator reuses the map nodes.
+    map<uint32_t, uint32_t> strategies;
+};
+
+void RaceSweep::runWorker(SweepResults& results, vector<PitRecord>& pits) {
+    // Thread-local arena: per-race scratch is bump-allocated from this block and
+    // released in one go after each race instead of going through malloc/free.
+    vector<byte> arena_storage(ARENA_BYTES);
+    pmr::monotonic_buffer_resource arena(arena_storage.data(), arena_storage.size());
+
+    Worker worker;
+    worker.rigs.resize(config_.tracks.size());
+    for(uint32_t i = 0; i < profiles_->drivers().size(); i++) {
+        worker.strategies[i] = SimKernel::NO_PLAN;
+    }
+
+    while(true) {
+        size_t index = next_race_.fetch_add(1, memory_order_relaxed);
+        if(index >= races_.size()) break;
+
+        runRace(races_[index], worker, results, pits, &arena);
+        arena.release();
+    }
+}
+
+void RaceSweep::runRace(const RaceSpec& spec, Worker& worker, SweepResults& results, vector<PitRecord>& pits, pmr::memory_resource* arena) {
+    const TrackProfile& track = config_.tracks[spec.track_index];
+    const uint32_t n_drivers = static_cast<uint32_t>(profiles_->drivers().size());
+
+    auto& rig = worker.rigs[spec.track_index];
+    if(!rig) {
+        rig = make_unique<TrackRig>(track, profiles_, make_shared<PenaltyEnforcer>(n_drivers));
+    }
+    PenaltyEnforcer& penalty_enforcer = *rig->penalty_enforcer;
+    TelemetryGenerator& generator = rig->generator;
+    TrackLimitsMonitor& track_limits_monitor = rig->track_limits_monitor;
+
+    penalty_enforcer.reset();
+    track_limits_monitor.reset(spec.seed);
+    for(auto& [driver_id, pit_lap] : worker.strategies) {
+        pit_lap = spec.strategy_pit_lap != 0 ? spec.strategy_pit_lap : SimKernel::NO_PLAN;
+    }
+    generator.setOptimalStrategies(worker.strategies);
+    generator.reset(spec.laps);
+
+    pmr::vector<uint8_t> in_pit(n_drivers, 0, arena);
+    pmr::vector<uint16_t> pit_count(n_drivers, 0, arena);
+    pmr::vector<float> finish_time_s(n_drivers, -1.0f, arena);
+    pmr::vector<TelemetryFrame> frames(n_drivers, TelemetryFrame{}, arena);
+    pmr::vector<TelemetryFrame> last_frames(n_drivers, TelemetryFrame{}, arena);
+    pmr::vector<PitRecord> race_pits(arena);
+    race_pits.reserve(n_drivers * 4);
+
+    uint64_t end_time_ns = 0;
+
+    // Same loop shape as the live producer/consumer: generate, check finish, then process.
+    while(true) {
+        generator.next(frames);
+
+        if(generator.isRaceFinished()) {
+            for(const auto& frame : frames) {
+                last_frames[frame.driver_id] = frame;
+            }
+            end_time_ns = frames[0].timestamp_ns;
+            break;
+        }
+
+        for(const auto& frame : frames) {
+            track_limits_monitor.processFrame(frame);
+
+            const uint32_t d = frame.driver_id;
+            const bool pitting = (frame.speed_kph == 0.0f);
+            if(pitting && !in_pit[d]) {
+                pit_count[d]++;
+                race_pits.push_back({spec.race_id, d, frame.lap});
+            }
+            in_pit[d] = pitting;
+
+            if(finish_time_s[d] < 0.0f && frame.lap >= spec.laps) {
+                finish_time_s[d] = static_cast<float>(frame.timestamp_ns * 1e-9);
+            }
+            last_frames[d] = frame;
+        }
+    }
+
+    const float race_duration_s = static_cast<float>(end_time_ns * 1e-9);
+    uint32_t winner = 0;
+
+    // Stage the driver rows locally: neighbouring races' rows share cache lines in
+    // the narrow columns, so each column is copied out once the race is done.
+    pmr::vector<uint16_t> finish_position(n_drivers, arena);
+    pmr::vector<uint32_t> laps_completed(n_drivers, arena);
+    pmr::vector<uint16_t> warnings(n_drivers, arena);
+    pmr::vector<uint8_t> penalized(n_drivers, arena);
+    for(uint32_t d = 0; d < n_drivers; d++) {
+        const auto& frame = last_frames[d];
+
+        if(frame.race_position == 1) winner = d;
+
+        DriverPenaltyInfo penalty = penalty_enforcer.getPenaltyInfo(d);
+
+        finish_position[d] = static_cast<uint16_t>(frame.race_position);
+        laps_completed[d] = frame.lap;
+        if(finish_time_s[d] < 0.0f) finish_time_s[d] = race_duration_s;
+        warnings[d] = static_cast<uint16_t>(track_limits_monitor.getWarnings(d));
+        penalized[d] = penalty.state != PenaltyState::NONE ? 1 : 0;
+    }
+
+    const size_t row0 = static_cast<size_t>(spec.race_id) * n_drivers;
+    fill_n(results.driver_race_id.begin() + row0, n_drivers, spec.race_id);
+    iota(results.driver_id.begin() + row0, results.driver_id.begin() + row0 + n_drivers, 0u);
+    copy(finish_position.begin(), finish_position.end(), results.driver_finish_position.begin() + row0);
+    copy(laps_completed.begin(), laps_completed.end(), results.driver_laps_completed.begin() + row0);
+    copy(finish_time_s.begin(), finish_time_s.end(), results.driver_finish_time_s.begin() + row0);
+    copy(pit_count.begin(), pit_count.end(), results.driver_pit_count.begin() + row0);
+    copy(warnings.begin(), warnings.end(), results.driver_warnings.begin() + row0);
+    copy(penalized.begin(), penalized.end(), results.driver_penalized.begin() + row0);
+
+    results.race_id[spec.race_id] = spec.race_id;
+    results.race_track_id[spec.race_id] = track.track_id;
+    results.race_laps[spec.race_id] = spec.laps;
+    results.race_strategy_pit_lap[spec.race_id] = spec.strategy_pit_lap;
+    results.race_seed[spec.race_id] = spec.seed;
+    results.race_winner[spec.race_id] = winner;
+    results.race_duration_s[spec.race_id] = race_duration_s;
+
+    pits.insert(pits.end(), race_pits.begin(), race_pits.end());
+}
+
+namespace {
+
+enum class ColumnType : uint8_t {
+    U8 = 0,
+    U16 = 1,
+    U32 = 2,
+    F32 = 3,
+};
+
+template<typename T> constexpr ColumnType columnTypeOf();
+template<> constexpr ColumnType columnTypeOf<uint8_t>() { return ColumnType::U8; }
+template<> constexpr ColumnType columnTypeOf<uint16_t>() { return ColumnType::U16; }
+template<> constexpr ColumnType columnTypeOf<uint32_t>() { return ColumnType::U32; }
+template<> constexpr ColumnType columnTypeOf<float>() { return ColumnType::F32; }
+
+void writeU32(ofstream& out, uint32_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeU64(ofstream& out, uint64_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeName(ofstream& out, const string& name) {
+    writeU32(out, static_cast<uint32_t>(name.size()));
+    out.write(name.data(), name.size());
+}
+
+void writeTableHeader(ofstream& out, const string& name, uint64_t rows, uint32_t columns) {
+    writeName(out, name);
+    writeU64(out, rows);
+    writeU32(out, columns);
+}
+
+template<typename T>
+void writeColumn(ofstream& out, const string& name, const vector<T>& column) {
+    writeName(out, name);
+    const uint8_t type = static_cast<uint8_t>(columnTypeOf<T>());
+    out.write(reinterpret_cast<const char*>(&type), sizeof(type));
+    out.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+}
+
+} // namespace
+
+bool RaceSweep::writeColumnar(const SweepResults& results, const string& path) {
+    ofstream out(path, ios::binary | ios::trunc);
+    if(!out) return false;
+
+    out.write("F1SWEEP", 8); // 7 chars + NUL
+    writeU32(out, 1);        // format version
+    writeU32(out, 3);        // table count
+
+    writeTableHeader(out, "races", results.race_id.size(), 7);
+    writeColumn(out, "race_id", results.race_id);
+    writeColumn(out, "track_id", results.race_track_id);
+    writeColumn(out, "laps", results.race_laps);
+    writeColumn(out, "strategy_pit_lap", results.race_strategy_pit_lap);
+    writeColumn(out, "seed", results.race_seed);
+    writeColumn(out, "winner", results.race_winner);
+    writeColumn(out, "duration_s", results.race_duration_s);
+
+    writeTableHeader(out, "drivers", results.driver_id.size(), 8);
+    writeColumn(out, "race_id", results.driver_race_id);
+    writeColumn(out, "driver_id", results.driver_id);
+    writeColumn(out, "finish_position", results.driver_finish_position);
+    writeColumn(out, "laps_completed", results.driver_laps_completed);
+    writeColumn(out, "finish_time_s", results.driver_finish_time_s);
+    writeColumn(out, "pit_count", results.driver_pit_count);
+    writeColumn(out, "warnings", results.driver_warnings);
+    writeColumn(out, "penalized", results.driver_penalized);
+
+    writeTableHeader(out, "pits", results.pit_lap.size(), 3);
+    writeColumn(out, "race_id", results.pit_race_id);
+    writeColumn(out, "driver_id", results.pit_driver_id);
+    writeColumn(out, "lap", results.pit_lap);
+
+    return static_cast<bool>(out);
+}
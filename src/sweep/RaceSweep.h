@@ -0,0 +1,101 @@
+#pragma once
+
+#include "../common/types.h"
+#include "../data/ProfileTable.h"
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <memory_resource>
+
+// One strategy setting applied to the whole grid.
+// pit_lap == 0 means every driver uses wear-based pitting.
+struct SweepStrategy {
+    uint32_t pit_lap;
+};
+
+struct SweepConfig {
+    std::vector<TrackProfile> tracks;
+    std::vector<uint32_t> lap_counts;
+    std::vector<SweepStrategy> strategies;
+    uint32_t seeds_per_combination;  // repeats with a different track-limits seed
+    uint32_t base_seed;
+    uint32_t threads;                // 0 = hardware concurrency
+};
+
+// Results are stored column-wise: one vector per field.
+// Race table: one row per simulated race.
+// Driver table: one row per (race, driver), grouped by race in race_id order.
+// Pit table: one row per pit stop, grouped by race in race_id order.
+struct SweepResults {
+    uint32_t driver_count = 0;
+
+    // Race table
+    std::vector<uint32_t> race_id;
+    std::vector<uint32_t> race_track_id;
+    std::vector<uint32_t> race_laps;
+    std::vector<uint32_t> race_strategy_pit_lap;
+    std::vector<uint32_t> race_seed;
+    std::vector<uint32_t> race_winner;
+    std::vector<float>    race_duration_s;
+
+    // Driver table
+    std::vector<uint32_t> driver_race_id;
+    std::vector<uint32_t> driver_id;
+    std::vector<uint16_t> driver_finish_position;
+    std::vector<uint32_t> driver_laps_completed;
+    std::vector<float>    driver_finish_time_s;  // time at which total laps were completed, or race end
+    std::vector<uint16_t> driver_pit_count;
+    std::vector<uint16_t> driver_warnings;
+    std::vector<uint8_t>  driver_penalized;
+
+    // Pit table
+    std::vector<uint32_t> pit_race_id;
+    std::vector<uint32_t> pit_driver_id;
+    std::vector<uint32_t> pit_lap;
+
+    size_t raceCount() const { return race_id.size(); }
+};
+
+class RaceSweep {
+public:
+    RaceSweep(const SweepConfig& config, std::shared_ptr<const ProfileTable> profiles);
+
+    SweepResults run();
+
+    size_t raceCount() const;
+
+    // Writes the results as a compact binary columnar file (see README for layout).
+    static bool writeColumnar(const SweepResults& results, const std::string& path);
+
+private:
+    struct RaceSpec {
+        uint32_t race_id;
+        uint32_t track_index;
+        uint32_t laps;
+        uint32_t strategy_pit_lap;
+        uint32_t seed;
+    };
+
+    struct PitRecord {
+        uint32_t race_id;
+        uint32_t driver_id;
+        uint32_t lap;
+    };
+
+    SweepConfig config_;
+    std::shared_ptr<const ProfileTable> profiles_;
+
+    std::vector<RaceSpec> races_;
+    std::atomic<size_t> next_race_;
+
+    static constexpr size_t ARENA_BYTES = 256 * 1024;
+
+    // A worker's race objects, built on first use of each track and reset between races.
+    struct TrackRig;
+    struct Worker;
+
+    void runWorker(SweepResults& results, std::vector<PitRecord>& pits);
+    void runRace(const RaceSpec& spec, Worker& worker, SweepResults& results, std::vector<PitRecord>& pits, std::pmr::memory_resource* arena);
+};
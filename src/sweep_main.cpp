@@ -0,0 +1,168 @@
+#include "sweep/RaceSweep.h"
+#include "data/season_data.h"
+#include "monitoring/MetricsExporter.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <map>
+#include <sstream>
+#include <string>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+vector<uint32_t> parseList(const string& input){
+    vector<uint32_t> values;
+    stringstream ss(input);
+    string item;
+    while(getline(ss, item, ',')){
+        if(item.empty()) continue;
+        try {
+            values.push_back(static_cast<uint32_t>(stoul(item)));
+        } catch(...) {
+            // Skip invalid entries
+        }
+    }
+    return values;
+}
+
+// Parses a whole number of at least `min` into `value`; false (leaving `value`
+// alone) on anything else, including trailing characters and negative numbers.
+bool parseCount(const string& input, uint32_t min, uint32_t& value){
+    if(input.empty() || input[0] == '-') return false;
+    try {
+        size_t used = 0;
+        const unsigned long parsed = stoul(input, &used);
+        if(used != input.size() || parsed < min || parsed > UINT32_MAX) return false;
+        value = static_cast<uint32_t>(parsed);
+        return true;
+    } catch(...) {
+        return false;
+    }
+}
+
+void printUsage(){
+    cout << "Usage: f1-sweep [options]\n"
+         << "  --profiles PATH    season profile file (default: built-in 2025 season)\n"
+         << "  --tracks 1,2,3     track ids from the season track library (default: all)\n"
+         << "  --laps 30,52       race lengths to simulate (default: 52)\n"
+         << "  --pit-laps 0,18    planned pit lap per strategy, 0 = wear-based (default: 0)\n"
+         << "  --seeds N          repeats per combination with different seeds, 1 or more (default: 10)\n"
+         << "  --seed N           base seed (default: 1)\n"
+         << "  --threads N        worker threads, 1 or more (default: all cores)\n"
+         << "  --out PATH         columnar output file (default: sweep_results.f1c)\n"
+         << "  --metrics-file PATH  write pipeline counters in Prometheus text format when done\n";
+}
+
+int invalidValue(const char* option, const char* value){
+    cerr << "Invalid value for " << option << ": " << value << "\n";
+    printUsage();
+    return 1;
+}
+
+int main(int argc, char** argv){
+    SweepConfig config;
+    config.lap_counts = {52};
+    config.strategies = {{0}};
+    config.seeds_per_combination = 10;
+    config.base_seed = 1;
+    config.threads = 0;
+
+    vector<uint32_t> track_ids;
+    string out_path = "sweep_results.f1c";
+    string metrics_path;
+    string profiles_path;
+
+    for(int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const bool has_value = (i + 1 < argc);
+
+        if(strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            printUsage();
+            return 0;
+        } else if(strcmp(arg, "--profiles") == 0 && has_value) {
+            profiles_path = argv[++i];
+        } else if(strcmp(arg, "--tracks") == 0 && has_value) {
+            track_ids = parseList(argv[++i]);
+        } else if(strcmp(arg, "--laps") == 0 && has_value) {
+            config.lap_counts = parseList(argv[++i]);
+        } else if(strcmp(arg, "--pit-laps") == 0 && has_value) {
+            config.strategies.clear();
+            for(uint32_t lap : parseList(argv[++i])) {
+                config.strategies.push_back({lap});
+            }
+        } else if(strcmp(arg, "--seeds") == 0 && has_value) {
+            if(!parseCount(argv[++i], 1, config.seeds_per_combination)) return invalidValue(arg, argv[i]);
+        } else if(strcmp(arg, "--seed") == 0 && has_value) {
+            if(!parseCount(argv[++i], 0, config.base_seed)) return invalidValue(arg, argv[i]);
+        } else if(strcmp(arg, "--threads") == 0 && has_value) {
+            if(!parseCount(argv[++i], 1, config.threads)) return invalidValue(arg, argv[i]);
+        } else if(strcmp(arg, "--out") == 0 && has_value) {
+            out_path = argv[++i];
+        } else if(strcmp(arg, "--metrics-file") == 0 && has_value) {
+            metrics_path = argv[++i];
+        } else {
+            cerr << "Unknown or incomplete option: " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    string error;
+    const shared_ptr<const ProfileTable> profiles = SeasonData::load(profiles_path, error);
+    if(!profiles) {
+        cerr << "Cannot load profiles: " << error << "\n";
+        return 1;
+    }
+
+    for(const auto& track : profiles->tracks()) {
+        bool selected = track_ids.empty();
+        for(uint32_t id : track_ids) {
+            if(id == track.track_id) selected = true;
+        }
+        if(selected) config.tracks.push_back(track);
+    }
+
+    if(config.tracks.empty() || config.lap_counts.empty() || config.strategies.empty() || config.seeds_per_combination == 0) {
+        cerr << "Empty sweep matrix, nothing to do.\n";
+        return 1;
+    }
+
+    RaceSweep sweep(config, profiles);
+
+    cout << "Simulating " << sweep.raceCount() << " races ("
+         << config.tracks.size() << " tracks x "
+         << config.lap_counts.size() << " lap counts x "
+         << config.strategies.size() << " strategies x "
+         << config.seeds_per_combination << " seeds)...\n";
+
+    auto start = chrono::steady_clock::now();
+    SweepResults results = sweep.run();
+    auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "Done in " << elapsed << " s (" << (results.raceCount() / elapsed) << " races/s)\n";
+
+    map<uint32_t, uint32_t> wins;
+    for(uint32_t winner : results.race_winner) {
+        wins[winner]++;
+    }
+    cout << "\nWins:\n";
+    for(const auto& [driver, count] : wins) {
+        cout << "  " << profiles->driverName(driver) << ": " << count << "\n";
+    }
+
+    if(!RaceSweep::writeColumnar(results, out_path)) {
+        cerr << "Failed to write " << out_path << "\n";
+        return 1;
+    }
+    cout << "\nResults written to " << out_path << "\n";
+
+    if(!metrics_path.empty()) {
+        ofstream metrics_out(metrics_path, ios::trunc);
+        MetricsExporter().render(metrics_out);
+        cout << "Metrics written to " << metrics_path << "\n";
+    }
+
+    return 0;
+}
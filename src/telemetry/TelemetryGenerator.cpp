@@ -1,23 +1,143 @@
 
 #include "TelemetryGenerator.h"
+#include "../monitoring/Instrumentation.h"
+#include "../monitoring/MetricsRegistry.h"
+#include "../common/SectorKernel.h"
 #include <algorithm>
 
 using namespace std;
 
+// Penalties served at stops, as tracked by race control.
+struct TelemetryGenerator::EnforcedPenalties {
+    static constexpr bool ENABLED = true;
+    PenaltyEnforcer* enforcer = nullptr;
+
+    uint64_t servedAtStop(uint32_t driver_id, uint64_t now_ns) {
+        return enforcer->shouldServePenalty(driver_id, now_ns) ? enforcer->getPenaltyInfo(driver_id).penalty_duration_ns : 0;
+    }
+    bool complete(uint32_t driver_id, uint64_t now_ns) {
+        return enforcer->isPenaltyComplete(driver_id, now_ns);
+    }
+};
+
+// Shapes the tick into the outgoing frame: speed drives progression as the
+// lap-average pace, and the track model turns it into the per-corner trace.
+struct TelemetryGenerator::FrameOutput {
+    const TrackModel& track_model;
+    const SimKernel::TrackConstants& constants;
+    const CarProfile& car;
+    uint8_t car_class;
+    TelemetryFrame& frame;
+
+    void emit(uint32_t driver_id, DriverState& state, float speed, bool held, uint64_t now_ns) {
+        float speed_trace = 0.0f;
+        float throttle = 0.0f;
+        float brake = 0.0f;
+        float tire_target[4] = {60.0f, 60.0f, 60.0f, 60.0f};
+
+        if (!held) {
+            const float lap_km = (static_cast<float>(state.sector) - 1.0f) * constants.sector_length_km + state.distance_in_lap;
+            const auto& sample = track_model.sample(lap_km);
+            speed_trace = speed * sample.speed_factor;
+            throttle = sample.throttle;
+            brake = sample.brake;
+
+            // Downforce adds vertical load (and heat) in corners; better cooling caps the peaks.
+            const float load_gain = (0.6f + car.aero_efficiency * 0.8f) * (1.0f - car.cooling_efficiency * 0.4f);
+            const float rolling = 70.0f + speed_trace * 0.05f;
+            const float left = max(-sample.lateral_load, 0.0f);
+            const float right = max(sample.lateral_load, 0.0f);
+            const float load[4] = {
+                left + sample.front_load,
+                right + sample.front_load,
+                left + sample.rear_load,
+                right + sample.rear_load,
+            };
+            for(int t = 0; t < 4; t++) {
+                tire_target[t] = clamp(rolling + 30.0f * load[t] * load_gain, 60.0f, 130.0f);
+            }
+        }
+
+        // Carcass temperature lags the surface load.
+        constexpr float temp_response = 0.1f;
+        for(int t = 0; t < 4; t++) {
+            state.tire_temp_c[t] += (tire_target[t] - state.tire_temp_c[t]) * temp_response;
+        }
+
+        frame = TelemetryFrame{};
+        frame.timestamp_ns = now_ns;
+        frame.driver_id = driver_id;
+        frame.lap = state.lap;
+        frame.sector = state.sector;
+        frame.car_class = car_class;
+        frame.speed_kph = speed_trace;
+        frame.throttle = throttle;
+        frame.brake = brake;
+        frame.tire_wear = state.tire_wear;
+        for(int t = 0; t < 4; t++) {
+            frame.tire_temp_c[t] = state.tire_temp_c[t];
+        }
+    }
+};
+
 TelemetryGenerator::TelemetryGenerator(
     const TrackProfile& track,
-    const vector<DriverProfile>& drivers,
-    const vector<CarProfile>& cars,
+    shared_ptr<const ProfileTable> profiles,
     uint32_t total_laps,
     std::shared_ptr<PenaltyEnforcer> penalty_enforcer
-) : track_(track), drivers_(drivers), cars_(cars), total_laps_(total_laps), current_time_ns_(0), penalty_enforcer_(penalty_enforcer) {
-    states_.resize(drivers.size());
+) : TelemetryGenerator(track, profiles, profiles->defaultGrid(), total_laps, penalty_enforcer) {}
+
+TelemetryGenerator::TelemetryGenerator(
+    const TrackProfile& track,
+    shared_ptr<const ProfileTable> profiles,
+    const vector<GridEntry>& grid,
+    uint32_t total_laps,
+    std::shared_ptr<PenaltyEnforcer> penalty_enforcer,
+    std::shared_ptr<ForkJoinPool> pool
+) : track_(track), track_model_(track), constants_(SimKernel::TrackConstants::of(track)), profiles_(std::move(profiles)), drivers_(profiles_->drivers()), cars_(profiles_->cars()), grid_(grid), total_laps_(total_laps), current_time_ns_(0),
+    penalty_enforcer_(penalty_enforcer), pool_(pool) {
+    // Pick the tick kernel once: nearly every track has 3 sectors, and without an
+    // enforcer stops skip the penalty lookups altogether.
+    const bool fixed_sectors = track_.sectors == 3 && SectorKernel::canSpecialize(constants_.sector_length_km);
+    if(penalty_enforcer_) {
+        range_kernel_ = fixed_sectors ? &TelemetryGenerator::generateRange<3, EnforcedPenalties>
+                                      : &TelemetryGenerator::generateRange<SectorKernel::DYNAMIC, EnforcedPenalties>;
+    } else {
+        range_kernel_ = fixed_sectors ? &TelemetryGenerator::generateRange<3, SimKernel::NoPenalties>
+                                      : &TelemetryGenerator::generateRange<SectorKernel::DYNAMIC, SimKernel::NoPenalties>;
+    }
+
+    states_.resize(grid_.size());
+    distance_.resize(grid_.size());
+    order_.resize(grid_.size());
+
+    uint8_t max_class = 0;
+    for(const auto& entry : grid_) {
+        max_class = max(max_class, entry.car_class);
+    }
+    class_count_.assign(static_cast<size_t>(max_class) + 1, 0);
+
+    resetGrid();
+}
+
+void TelemetryGenerator::reset(uint32_t total_laps) {
+    total_laps_ = total_laps;
+    current_time_ns_ = 0;
+    resetGrid();
+}
+
+void TelemetryGenerator::resetGrid() {
+    fill(distance_.begin(), distance_.end(), 0.0f);
+    for(uint32_t i = 0; i < order_.size(); i++) {
+        order_[i] = i;
+    }
 
     for (auto &s : states_){
         s.lap = 0;
         s.sector = 1;
         s.tire_wear = 0.0f;
         s.distance_in_lap = 0.0f;
+        for(float& t : s.tire_temp_c) t = 70.0f;
         s.is_on_pit = false;
         s.has_pitted = false;
         s.pit_stop_start_time_ns = 0;
@@ -25,148 +145,128 @@ TelemetryGenerator::TelemetryGenerator(
     }
 }
 
-vector<TelemetryFrame> TelemetryGenerator::next() {
-    constexpr uint64_t tick_ns = 20'000'000ULL; // 20ms in nanoseconds
-    current_time_ns_ += tick_ns;
-
-    vector<TelemetryFrame> frames;
-    frames.reserve(drivers_.size());
+void TelemetryGenerator::next(span<TelemetryFrame> out) {
+    current_time_ns_ += SimKernel::TICK_NS;
 
-    for(uint32_t i = 0; i < drivers_.size(); i++) {
-        frames.push_back(generateFrame(i));
+    const size_t n = grid_.size();
+    if(pool_ && pool_->parallelism() > 1 && n >= 2 * SHARD_SIZE) {
+        // Entries are independent within a tick, so shards only touch their own
+        // states, frames and distances; positions are merged afterwards.
+        const size_t shards = (n + SHARD_SIZE - 1) / SHARD_SIZE;
+        pool_->run(shards, [&](size_t shard) {
+            const size_t begin = shard * SHARD_SIZE;
+            (this->*range_kernel_)(begin, min(n, begin + SHARD_SIZE), out);
+        });
+    } else {
+        (this->*range_kernel_)(0, n, out);
     }
 
-    calculatePositions(frames);
-
-    return frames;
+    calculatePositions(out);
+    Instrumentation::stampGenerated(out.first(n), current_time_ns_ / SimKernel::TICK_NS);
+    Metrics::increment(Counter::TICKS_GENERATED);
 }
 
-float TelemetryGenerator::getTotalDistance(uint32_t driver_id) const {
-    const auto& s = states_[driver_id];
-    const float sector_length = track_.lap_length_km / track_.sectors;
-    const float sector_offset = (static_cast<float>(s.sector) - 1.0f) * sector_length;
-    return s.lap * track_.lap_length_km + sector_offset + s.distance_in_lap;
-}
+template<uint8_t SECTORS, typename Penalties>
+void TelemetryGenerator::generateRange(size_t begin, size_t end, span<TelemetryFrame> out) {
+    Penalties penalties{};
+    if constexpr (Penalties::ENABLED) penalties.enforcer = penalty_enforcer_.get();
 
-void TelemetryGenerator::calculatePositions(vector<TelemetryFrame>& frames) {
-    vector<pair<uint32_t, float>> positions;
-    for(uint32_t i = 0; i < drivers_.size(); i++) {
-        positions.push_back({i, getTotalDistance(i)});
-    }
-    sort(positions.begin(), positions.end(), [](const pair<uint32_t, float>& a, const pair<uint32_t, float>& b) {
-        return a.second > b.second;
-    });
-    for(uint32_t i = 0; i < positions.size(); i++) {
-        uint32_t driver_id = positions[i].first;
-        frames[driver_id].race_position = static_cast<uint8_t>(i + 1);
+    for(size_t i = begin; i < end; i++) {
+        generateFrame<SECTORS>(static_cast<uint32_t>(i), out[i], penalties);
+        distance_[i] = getTotalDistance(static_cast<uint32_t>(i));
     }
 }
 
-TelemetryFrame TelemetryGenerator::generateFrame(uint32_t i) {
-    auto& state = states_[i];
-    const auto& driver = drivers_[i];
-    const auto& car = cars_[i];
-
-    float base_threshold = 0.65f + (driver.tire_management * 0.25f);
-    float risk_adjustment = (driver.risk_tolerance - 0.5f) * 0.15f;
-    float pit_threshold = base_threshold + risk_adjustment;
-
-    bool should_pit = false;
-    const bool has_optimal = (optimal_strategies_.find(i) != optimal_strategies_.end());
+size_t TelemetryGenerator::driverCount() const {
+    return grid_.size();
+}
 
-    if (has_optimal) {
-        // If an optimal strategy is provided, follow it exactly (and only once).
-        const uint32_t optimal_pit_lap = optimal_strategies_[i];
-        should_pit = (state.lap == optimal_pit_lap) && !state.is_on_pit && !state.has_pitted;
-    } else {
-        // Otherwise pit based on tire wear (can happen multiple times across the race).
-        should_pit = (state.tire_wear > pit_threshold) && !state.is_on_pit;
-    }
+float TelemetryGenerator::getTotalDistance(uint32_t driver_id) const {
+    const auto& s = states_[driver_id];
+    const float sector_offset = (static_cast<float>(s.sector) - 1.0f) * constants_.sector_length_km;
+    return s.lap * track_.lap_length_km + sector_offset + s.distance_in_lap;
+}
 
-    if (should_pit && !state.is_on_pit) {
-        state.is_on_pit = true;
-        if (has_optimal) state.has_pitted = true; // consume the planned pit
-        state.pit_stop_start_time_ns = current_time_ns_;
-        uint64_t pit_duration = static_cast<uint64_t>((2.0f + (1.0f - car.reliability) * 1.0f) * 1e9);
+void TelemetryGenerator::calculatePositions(span<TelemetryFrame> frames) {
+    // Further along first, lower id on ties: a strict total order, so the result
+    // does not depend on how the tick was sharded.
+    const auto ahead = [this](uint32_t a, uint32_t b) {
+        return distance_[a] > distance_[b] || (distance_[a] == distance_[b] && a < b);
+    };
 
-        if (penalty_enforcer_ && penalty_enforcer_->shouldServePenalty(i, current_time_ns_)) {
-            // Add the configured penalty duration (in simulation time) to this pit stop.
-            pit_duration += penalty_enforcer_->getPenaltyInfo(i).penalty_duration_ns;
+    // Insertion sort over last tick's order costs one pass plus one move per
+    // overtake. A pit stop or the first tick can reshuffle the field, so fall
+    // back to a full sort once the moves exceed a few passes' worth.
+    const size_t n = order_.size();
+    const size_t move_budget = 4 * n;
+    size_t moves = 0;
+    for(size_t i = 1; i < n && moves <= move_budget; i++) {
+        const uint32_t id = order_[i];
+        size_t j = i;
+        while(j > 0 && ahead(id, order_[j - 1])) {
+            order_[j] = order_[j - 1];
+            j--;
         }
-        state.pit_stop_end_time_ns = current_time_ns_ + pit_duration;
+        order_[j] = id;
+        moves += i - j;
     }
-
-    if (state.is_on_pit &&
-        current_time_ns_ >= state.pit_stop_end_time_ns &&
-        (!penalty_enforcer_ || penalty_enforcer_->isPenaltyComplete(i, current_time_ns_))) {
-        state.is_on_pit = false;
-        state.tire_wear = 0.0f;
+    if(moves > move_budget) {
+        sort(order_.begin(), order_.end(), ahead);
     }
 
-    float speed = 0.0f;
-    if (!state.is_on_pit) {
-        float driver_skill = 0.80f + driver.consistency * 0.25f;
-        speed = 220.0f * car.engine_power * driver_skill * (1.0f - state.tire_wear * 0.4f);
+    fill(class_count_.begin(), class_count_.end(), 0);
+    for(uint32_t i = 0; i < n; i++) {
+        auto& frame = frames[order_[i]];
+        frame.race_position = i + 1;
+        frame.class_position = ++class_count_[frame.car_class];
     }
+}
 
-    if (!state.is_on_pit) {
-        constexpr float tick_seconds = 0.02f;
-        constexpr float sim_speed_multiplier = 120.0f;
-        const float delta_distance_km = speed * (tick_seconds / 3600.0f) * sim_speed_multiplier;
+template<uint8_t SECTORS, typename Penalties>
+void TelemetryGenerator::generateFrame(uint32_t i, TelemetryFrame& frame, Penalties& penalties) {
+    auto& state = states_[i];
+    const auto& entry = grid_[i];
+    const auto& driver = drivers_[entry.driver_index];
+    const auto& car = cars_[entry.car_index];
 
-        // Tire wear scales with distance traveled (not per tick), so pit timing stays stable if sim speed changes.
-        // Tuned so typical first stops fall roughly in the 15–25 lap range depending on driver traits and track.
-        const float wear_per_lap = 0.05f * driver.aggression * track_.tire_wear_factor; // 0..~0.05 per lap
-        state.tire_wear += (delta_distance_km / track_.lap_length_km) * wear_per_lap;
-        if (state.tire_wear > 1.0f) state.tire_wear = 1.0f;
+    // An optimal strategy is followed exactly (and only once); without one the car
+    // pits on tire wear. find() only: shards read the map concurrently.
+    const auto optimal = optimal_strategies_.find(i);
+    const uint32_t planned_lap = (optimal != optimal_strategies_.end()) ? optimal->second : SimKernel::NO_PLAN;
+    const bool should_pit = SimKernel::shouldPit<SimKernel::TimedPit>(state, driver, planned_lap);
 
-        state.distance_in_lap += delta_distance_km;
+    FrameOutput frames{track_model_, constants_, car, entry.car_class, frame};
+    SimKernel::NoTraffic traffic;
+    SimKernel::tick<SimKernel::TimedPit, SECTORS>(constants_, i, driver, car, state, should_pit, current_time_ns_, penalties, frames, traffic);
+}
 
-        float sector_length = track_.lap_length_km / track_.sectors;
+bool TelemetryGenerator::isRaceFinished() const {
+    if(order_.empty()) return true;
+    // order_ is refreshed every tick, so the leader is already known.
+    return states_[order_[0]].lap >= total_laps_;
+}
 
-        while (state.distance_in_lap >= sector_length) {
-            state.distance_in_lap -= sector_length;
-            state.sector++;
+void TelemetryGenerator::setOptimalStrategies(const std::map<uint32_t, uint32_t>& strategies) {
+    optimal_strategies_ = strategies;
+}
 
-            if (state.sector > track_.sectors) {
-                state.sector = 1;
-                state.lap++;
-            }
-        }
-    }
+GeneratorSnapshot TelemetryGenerator::snapshot() const {
+    return GeneratorSnapshot{current_time_ns_, states_, optimal_strategies_};
+}
 
-    TelemetryFrame frame{};
-    frame.timestamp_ns = current_time_ns_;
-    frame.driver_id = i;
-    frame.lap = state.lap;
-    frame.sector = state.sector;
-    frame.speed_kph = speed;
-    frame.throttle = 1.0f;
-    frame.brake = 0.0f;
-    frame.tire_wear = state.tire_wear;
-    float base_temp = state.is_on_pit ? 60.0f : clamp(80.0f + speed * 0.05f, 60.0f, 120.0f);
-    for(int t = 0; t < 4; t++) {
-        frame.tire_temp_c[t] = base_temp;
-    }
+bool TelemetryGenerator::restore(const GeneratorSnapshot& snapshot) {
+    if(snapshot.states.size() != states_.size()) return false;
 
-    return frame;
-}
+    current_time_ns_ = snapshot.current_time_ns;
+    states_ = snapshot.states;
+    optimal_strategies_ = snapshot.optimal_strategies;
 
-bool TelemetryGenerator::isRaceFinished() const {
-    float max_distance = 0;
-    uint32_t leader_idx = 0;
-    
+    // The running order is fully determined by the states (ties break on id).
     for(uint32_t i = 0; i < states_.size(); i++) {
-        float total_distance = getTotalDistance(i);
-        if(total_distance > max_distance) {
-            max_distance = total_distance;
-            leader_idx = i;
-        }
+        distance_[i] = getTotalDistance(i);
     }
-    
-    return states_[leader_idx].lap >= total_laps_;
+    sort(order_.begin(), order_.end(), [this](uint32_t a, uint32_t b) {
+        return distance_[a] > distance_[b] || (distance_[a] == distance_[b] && a < b);
+    });
+    return true;
 }
-
-void TelemetryGenerator::setOptimalStrategies(const std::map<uint32_t, uint32_t>& strategies) {
-    optimal_strategies_ = strategies;
-}
\ No newline at end of file
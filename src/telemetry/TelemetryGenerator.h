@@ -2,23 +2,62 @@
 
 #include <vector>
 #include <map>
+#include <memory>
+#include <span>
 #include <cstdint>
 #include "../common/types.h"
+#include "../data/ProfileTable.h"
 #include "../race-control/PenaltyEnforcer.h"
+#include "../common/ForkJoinPool.h"
+#include "../common/SimKernel.h"
+#include "TrackModel.h"
+
+// Simulation state of a TelemetryGenerator at a tick boundary. Everything else
+// the generator holds is configuration or per-tick scratch.
+struct GeneratorSnapshot {
+    uint64_t current_time_ns;
+    std::vector<DriverState> states;
+    std::map<uint32_t, uint32_t> optimal_strategies;
+};
 
 class TelemetryGenerator {
 public:
-    TelemetryGenerator(const TrackProfile& track, const std::vector<DriverProfile>& drivers, const std::vector<CarProfile>& cars, uint32_t total_laps, std::shared_ptr<PenaltyEnforcer> penalty_enforcer);
+    // Single-class grid where driver i drives car i.
+    TelemetryGenerator(const TrackProfile& track, std::shared_ptr<const ProfileTable> profiles, uint32_t total_laps, std::shared_ptr<PenaltyEnforcer> penalty_enforcer);
+
+    // Explicit grid: frame driver ids are indices into `grid`. With a `pool`, grids
+    // large enough to be worth splitting are generated in parallel shards; the
+    // output is identical whatever the pool size.
+    TelemetryGenerator(const TrackProfile& track, std::shared_ptr<const ProfileTable> profiles, const std::vector<GridEntry>& grid, uint32_t total_laps, std::shared_ptr<PenaltyEnforcer> penalty_enforcer, std::shared_ptr<ForkJoinPool> pool = nullptr);
 
-    std::vector<TelemetryFrame> next();
+    // Advances the simulation one tick and writes one frame per grid entry into `out`
+    // (indexed by driver id). `out` must hold at least driverCount() frames; the
+    // caller owns and reuses the storage, so steady-state ticks do not allocate.
+    void next(std::span<TelemetryFrame> out);
+    size_t driverCount() const;
     bool isRaceFinished() const;
 
     void setOptimalStrategies(const std::map<uint32_t, uint32_t>& strategies);
 
+    GeneratorSnapshot snapshot() const;
+    // Fails (and leaves the generator untouched) if the snapshot is for a different grid size.
+    bool restore(const GeneratorSnapshot& snapshot);
+    // Restarts the race from the grid over `total_laps`, keeping the storage and the
+    // strategies from setOptimalStrategies(). Runs identically to a new generator.
+    void reset(uint32_t total_laps);
+
 private:
+    // Cars per parallel shard; smaller grids are generated on the calling thread.
+    static constexpr size_t SHARD_SIZE = 256;
+
     TrackProfile track_;
-    std::vector<DriverProfile> drivers_;
-    std::vector<CarProfile> cars_;
+    TrackModel track_model_;
+    SimKernel::TrackConstants constants_;
+    // Shared, immutable profiles; the spans view into them.
+    std::shared_ptr<const ProfileTable> profiles_;
+    std::span<const DriverProfile> drivers_;
+    std::span<const CarProfile> cars_;
+    std::vector<GridEntry> grid_;
     uint32_t total_laps_;
 
     uint64_t current_time_ns_; // simulation time
@@ -28,10 +67,31 @@ private:
     std::vector<DriverState> states_;
 
     std::shared_ptr<PenaltyEnforcer> penalty_enforcer_;
+    std::shared_ptr<ForkJoinPool> pool_;
+
+    // Total distance per entry, written by generateFrame() so shards never share state.
+    std::vector<float> distance_;
+    // Running order, kept from the previous tick: it barely changes between ticks,
+    // so re-sorting it is close to linear.
+    std::vector<uint32_t> order_;
+    std::vector<uint32_t> class_count_;
+
+    // SimKernel policies: penalties from the enforcer, and frames shaped by the track model.
+    struct EnforcedPenalties;
+    struct FrameOutput;
+
+    // Tick kernels, specialized on sector count (SectorKernel::DYNAMIC = any) and on
+    // whether there is a penalty enforcer.
+    using RangeKernel = void (TelemetryGenerator::*)(size_t, size_t, std::span<TelemetryFrame>);
+    RangeKernel range_kernel_;
 
-    TelemetryFrame generateFrame(uint32_t driver_id);
+    template<uint8_t SECTORS, typename Penalties>
+    void generateFrame(uint32_t driver_id, TelemetryFrame& frame, Penalties& penalties);
+    template<uint8_t SECTORS, typename Penalties>
+    void generateRange(size_t begin, size_t end, std::span<TelemetryFrame> out);
 
-    void calculatePositions(std::vector<TelemetryFrame>& frames);
+    void resetGrid();
+    void calculatePositions(std::span<TelemetryFrame> frames);
 
     float getTotalDistance(uint32_t driver_id) const;
 };
\ No newline at end of file
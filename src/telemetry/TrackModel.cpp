@@ -0,0 +1,114 @@
+#include "TrackModel.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace std;
+
+namespace {
+
+// Speed-factor change per km of track: cars brake far harder than they accelerate.
+constexpr float ACCEL_PER_KM = 1.5f;
+constexpr float BRAKE_PER_KM = 6.0f;
+constexpr float MIN_CORNER_SPEED = 0.3f;
+
+} // namespace
+
+TrackModel::TrackModel(const TrackProfile& track) : inv_bin_km_(1.0f / BIN_KM) {
+    buildSegments(track);
+    buildSamples(track);
+}
+
+void TrackModel::buildSegments(const TrackProfile& track) {
+    // Seeded from the track id so a given track always has the same layout.
+    mt19937 gen(track.track_id * 2654435761u + 1u);
+    uniform_real_distribution<float> straight_share(0.55f, 0.8f);
+    uniform_real_distribution<float> severity(0.15f, 0.9f);
+
+    const uint8_t sectors = max<uint8_t>(track.sectors, 1);
+    const float sector_length = track.lap_length_km / sectors;
+
+    for(uint8_t s = 0; s < sectors; s++) {
+        const uint32_t corners = 2 + gen() % 3;
+        const float block_length = sector_length / corners;
+
+        for(uint32_t c = 0; c < corners; c++) {
+            const float block_start = s * sector_length + c * block_length;
+            const float straight_length = block_length * straight_share(gen);
+            const float direction = (gen() & 1) ? 1.0f : -1.0f;
+
+            segments_.push_back({SegmentType::STRAIGHT, block_start, straight_length, 0.0f, 0.0f});
+            segments_.push_back({SegmentType::CORNER, block_start + straight_length, block_length - straight_length, severity(gen), direction});
+        }
+    }
+}
+
+void TrackModel::buildSamples(const TrackProfile& track) {
+    const size_t n = max<size_t>(1, static_cast<size_t>(ceil(track.lap_length_km / BIN_KM)));
+
+    // Per-bin speed cap and the segment each bin falls in.
+    vector<float> speed(n);
+    vector<uint32_t> segment_of(n);
+    uint32_t seg = 0;
+    for(size_t i = 0; i < n; i++) {
+        const float x = (i + 0.5f) * BIN_KM;
+        while(seg + 1 < segments_.size() && x >= segments_[seg + 1].start_km) seg++;
+        segment_of[i] = seg;
+
+        const auto& segment = segments_[seg];
+        speed[i] = segment.type == SegmentType::CORNER
+            ? max(MIN_CORNER_SPEED, 1.0f - 0.7f * segment.severity)
+            : 1.0f;
+    }
+
+    // Traction limit forwards, braking limit backwards. Two laps each so the
+    // constraint carries across the start/finish line.
+    const float accel = ACCEL_PER_KM * BIN_KM;
+    const float brake = BRAKE_PER_KM * BIN_KM;
+    for(size_t k = 1; k < 2 * n; k++) {
+        const size_t i = k % n;
+        const size_t prev = (k - 1) % n;
+        speed[i] = min(speed[i], speed[prev] + accel);
+    }
+    for(size_t k = 2 * n - 1; k > 0; k--) {
+        const size_t i = (k - 1) % n;
+        const size_t next = k % n;
+        speed[i] = min(speed[i], speed[next] + brake);
+    }
+
+    float mean = 0.0f;
+    for(float v : speed) mean += v;
+    mean /= static_cast<float>(n);
+
+    samples_.resize(n);
+    for(size_t i = 0; i < n; i++) {
+        const auto& segment = segments_[segment_of[i]];
+        const float dv = speed[(i + 1) % n] - speed[i];
+        auto& sample = samples_[i];
+
+        sample.speed_factor = speed[i] / mean;
+        sample.lateral_load = 0.0f;
+        sample.front_load = 0.0f;
+        sample.rear_load = 0.0f;
+
+        if(dv < -1e-4f) {
+            sample.brake = min(1.0f, -dv / brake);
+            sample.throttle = 0.0f;
+            sample.front_load = sample.brake;
+        } else if(dv > 1e-4f) {
+            sample.brake = 0.0f;
+            sample.throttle = 1.0f;
+            sample.rear_load = min(1.0f, dv / accel);
+        } else {
+            sample.brake = 0.0f;
+            sample.throttle = segment.type == SegmentType::CORNER ? 0.35f + 0.5f * (1.0f - segment.severity) : 1.0f;
+            sample.rear_load = 0.2f * sample.throttle;
+        }
+
+        if(segment.type == SegmentType::CORNER) {
+            // Fast corners pull more lateral g than tight ones. A left-hander loads
+            // the outside (right-hand) tires.
+            sample.lateral_load = segment.direction * (0.6f + 0.4f * (1.0f - segment.severity));
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../common/types.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Corner/straight layout of a track, baked into a fixed-resolution lookup table
+// so per-tick channel generation is a single indexed load.
+//
+// TrackProfile carries no geometry, so the layout is derived deterministically
+// from track_id: every sector gets a few corners of varying severity separated
+// by straights. The speed trace is shaped by forward (traction) and backward
+// (braking) passes, then normalized to a lap mean of 1.0 so the trace modulates
+// the pace model without changing lap times.
+class TrackModel {
+public:
+    enum class SegmentType : uint8_t {
+        STRAIGHT,
+        CORNER
+    };
+
+    struct Segment {
+        SegmentType type;
+        float start_km;
+        float length_km;
+        float severity;   // 0 (flat out) - 1 (hairpin), corners only
+        float direction;  // +1 left-hander, -1 right-hander, 0 straight
+    };
+
+    // Channel values for one bin of the lap.
+    struct Sample {
+        float speed_factor;   // multiplier on the car's pace speed
+        float throttle;       // 0.0 - 1.0
+        float brake;          // 0.0 - 1.0
+        float lateral_load;   // >0 loads the right-hand tires, <0 the left
+        float front_load;     // braking weight transfer
+        float rear_load;      // traction weight transfer
+    };
+
+    static constexpr float BIN_KM = 0.01f; // 10 m resolution
+
+    explicit TrackModel(const TrackProfile& track);
+
+    // `lap_km` is the distance into the current lap; out-of-range values clamp.
+    const Sample& sample(float lap_km) const {
+        int32_t bin = static_cast<int32_t>(lap_km * inv_bin_km_);
+        if(bin < 0) bin = 0;
+        if(bin >= static_cast<int32_t>(samples_.size())) bin = static_cast<int32_t>(samples_.size()) - 1;
+        return samples_[bin];
+    }
+
+    const std::vector<Segment>& segments() const { return segments_; }
+    size_t binCount() const { return samples_.size(); }
+
+private:
+    std::vector<Segment> segments_;
+    std::vector<Sample> samples_;
+    float inv_bin_km_;
+
+    void buildSegments(const TrackProfile& track);
+    void buildSamples(const TrackProfile& track);
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../common/types.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <signal.h>
+#include <sys/types.h>
+
+// Layout of the shared-memory telemetry ring. One process (ShmPublisher) writes and
+// any number of local processes (ShmReader) map the same segment and read frames in
+// place. Everything here is fixed-size and position-independent, since each process
+// maps the segment at a different address.
+//
+//     [Header][Slot 0][Slot 1]...[Slot capacity-1]
+//
+// Frame n lives in slot n % capacity. The writer never waits for readers: a reader
+// that falls more than `capacity` frames behind skips ahead and counts the frames it
+// lost, so a slow or crashed reader cannot stall the race.
+namespace ShmLayout {
+
+constexpr char MAGIC[8] = "F1SHM";    // 5 chars + NUL, padded to 8
+constexpr uint32_t VERSION = 1;
+constexpr size_t MAX_READERS = 32;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory cursors must be lock-free");
+static_assert(std::atomic<int32_t>::is_always_lock_free, "shared-memory cursors must be lock-free");
+
+// A reader's registration. Cursors are private to each reader; they are published
+// here only so the writer and tools can report lag. pid 0 marks a free entry, and an
+// entry whose process has died is reclaimed by the next reader that needs one.
+struct alignas(64) ReaderEntry {
+    std::atomic<int32_t> pid;
+    std::atomic<uint64_t> cursor;   // next sequence number the reader will read
+    std::atomic<uint64_t> lost;     // frames overwritten before the reader got to them
+};
+
+struct alignas(64) Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t frame_size;            // sizeof(TelemetryFrame) in the writer's build
+    uint64_t capacity;              // slots, a power of two
+    uint32_t driver_count;          // frames per tick
+    int32_t writer_pid;
+    std::atomic<uint32_t> ready;    // set last, once the fields above are written
+    std::atomic<uint32_t> closed;   // the writer has published its last frame
+
+    alignas(64) std::atomic<uint64_t> write_seq;   // frames published so far
+
+    ReaderEntry readers[MAX_READERS];
+};
+
+// Per-slot sequence lock: 2n+1 while frame n is being written, 2n+2 once it is
+// complete. A reader that sees the same even value before and after using the frame
+// knows the frame was not overwritten meanwhile.
+struct alignas(64) Slot {
+    std::atomic<uint64_t> seq;
+    TelemetryFrame frame;
+};
+
+inline uint64_t writingSeq(uint64_t n) { return 2 * n + 1; }
+inline uint64_t publishedSeq(uint64_t n) { return 2 * n + 2; }
+
+inline size_t segmentSize(size_t capacity) {
+    return sizeof(Header) + capacity * sizeof(Slot);
+}
+
+inline Slot* slots(Header* header) {
+    return reinterpret_cast<Slot*>(reinterpret_cast<char*>(header) + sizeof(Header));
+}
+
+// True if `pid` names a running process (or one we may not signal).
+inline bool processAlive(pid_t pid) {
+    return pid > 0 && (::kill(pid, 0) == 0 || errno != ESRCH);
+}
+
+} // namespace ShmLayout
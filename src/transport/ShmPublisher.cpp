@@ -0,0 +1,98 @@
+#include "ShmPublisher.h"
+#include <bit>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace std;
+
+ShmPublisher::~ShmPublisher() {
+    if(!header_) return;
+    close();
+    munmap(header_, mapped_bytes_);
+    // Readers still attached keep their mapping; the name is free for the next race.
+    shm_unlink(name_.c_str());
+}
+
+bool ShmPublisher::open(const string& name, size_t capacity, uint32_t driver_count) {
+    if(header_) {
+        error_ = "already open";
+        return false;
+    }
+
+    const size_t slots = bit_ceil(max<size_t>(capacity, 2));
+    const size_t bytes = ShmLayout::segmentSize(slots);
+
+    // A segment left behind by a crashed writer is replaced, not reused.
+    shm_unlink(name.c_str());
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if(fd < 0) {
+        error_ = "shm_open " + name + ": " + strerror(errno);
+        return false;
+    }
+    if(ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        error_ = "ftruncate " + name + ": " + strerror(errno);
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(memory == MAP_FAILED) {
+        error_ = "mmap " + name + ": " + strerror(errno);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // ftruncate zero-fills, which is a valid initial state for every atomic here:
+    // all slots unwritten, no frames published, no readers.
+    header_ = static_cast<ShmLayout::Header*>(memory);
+    memcpy(header_->magic, ShmLayout::MAGIC, sizeof(header_->magic));
+    header_->version = ShmLayout::VERSION;
+    header_->frame_size = sizeof(TelemetryFrame);
+    header_->capacity = slots;
+    header_->driver_count = driver_count;
+    header_->writer_pid = static_cast<int32_t>(getpid());
+    header_->ready.store(1, memory_order_release);
+
+    name_ = name;
+    slots_ = ShmLayout::slots(header_);
+    mapped_bytes_ = bytes;
+    mask_ = slots - 1;
+    next_seq_ = 0;
+    return true;
+}
+
+void ShmPublisher::publish(span<const TelemetryFrame> frames) {
+    if(!header_) return;
+
+    for(const TelemetryFrame& frame : frames) {
+        ShmLayout::Slot& slot = slots_[next_seq_ & mask_];
+        slot.seq.store(ShmLayout::writingSeq(next_seq_), memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        slot.frame = frame;
+        slot.seq.store(ShmLayout::publishedSeq(next_seq_), memory_order_release);
+        next_seq_++;
+    }
+    // One cursor update per tick, however many frames it carried.
+    header_->write_seq.store(next_seq_, memory_order_release);
+}
+
+void ShmPublisher::close() {
+    if(header_) header_->closed.store(1, memory_order_release);
+}
+
+vector<ShmPublisher::ReaderStatus> ShmPublisher::readers() const {
+    vector<ReaderStatus> out;
+    if(!header_) return out;
+
+    for(const auto& entry : header_->readers) {
+        const int32_t pid = entry.pid.load(memory_order_acquire);
+        if(pid == 0) continue;
+        const uint64_t cursor = entry.cursor.load(memory_order_relaxed);
+        out.push_back({pid, next_seq_ > cursor ? next_seq_ - cursor : 0,
+                       entry.lost.load(memory_order_relaxed), ShmLayout::processAlive(pid)});
+    }
+    return out;
+}
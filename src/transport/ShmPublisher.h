@@ -0,0 +1,48 @@
+#pragma once
+
+#include "ShmLayout.h"
+#include <span>
+#include <string>
+#include <vector>
+
+// Writer side of the shared-memory ring: owns the POSIX shm segment, publishes each
+// tick's frames once, and unlinks the segment when destroyed. Publishing never
+// blocks or allocates, whether there are no readers or many slow or crashed ones.
+class ShmPublisher {
+public:
+    struct ReaderStatus {
+        int32_t pid;
+        uint64_t lag;        // frames published but not yet read
+        uint64_t lost;
+        bool alive;
+    };
+
+    ShmPublisher() = default;
+    ~ShmPublisher();
+
+    ShmPublisher(const ShmPublisher&) = delete;
+    ShmPublisher& operator=(const ShmPublisher&) = delete;
+
+    // Creates the segment `name` (e.g. "/f1-telemetry"), replacing any left by a
+    // writer that crashed. `capacity` is rounded up to a power of two. False with
+    // error() set if the segment cannot be created.
+    bool open(const std::string& name, size_t capacity, uint32_t driver_count);
+
+    void publish(std::span<const TelemetryFrame> frames);
+
+    // Marks the stream finished; readers drain what is left and then stop.
+    void close();
+
+    uint64_t published() const { return next_seq_; }
+    std::vector<ReaderStatus> readers() const;
+    const std::string& error() const { return error_; }
+
+private:
+    std::string name_;
+    std::string error_;
+    ShmLayout::Header* header_ = nullptr;
+    ShmLayout::Slot* slots_ = nullptr;
+    size_t mapped_bytes_ = 0;
+    uint64_t mask_ = 0;
+    uint64_t next_seq_ = 0;
+};
@@ -0,0 +1,155 @@
+#include "ShmReader.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+ShmReader::~ShmReader() {
+    if(!header_) return;
+    if(entry_) entry_->pid.store(0, memory_order_release);
+    munmap(header_, mapped_bytes_);
+}
+
+bool ShmReader::attach(const string& name, bool from_oldest) {
+    if(header_) {
+        error_ = "already attached";
+        return false;
+    }
+
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if(fd < 0) {
+        error_ = "shm_open " + name + ": " + strerror(errno);
+        return false;
+    }
+    struct stat st;
+    if(fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmLayout::Header)) {
+        error_ = name + ": not a telemetry ring";
+        ::close(fd);
+        return false;
+    }
+    const size_t bytes = static_cast<size_t>(st.st_size);
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(memory == MAP_FAILED) {
+        error_ = "mmap " + name + ": " + strerror(errno);
+        return false;
+    }
+
+    auto* header = static_cast<ShmLayout::Header*>(memory);
+    if(header->ready.load(memory_order_acquire) != 1
+        || memcmp(header->magic, ShmLayout::MAGIC, sizeof(header->magic)) != 0
+        || header->version != ShmLayout::VERSION) {
+        error_ = name + ": not a telemetry ring (or its writer is still starting)";
+    } else if(header->frame_size != sizeof(TelemetryFrame)) {
+        // Instrumented and uninstrumented builds disagree on the frame layout.
+        error_ = name + ": frame size " + to_string(header->frame_size) + ", expected " + to_string(sizeof(TelemetryFrame));
+    } else if(bytes < ShmLayout::segmentSize(header->capacity)) {
+        error_ = name + ": segment is truncated";
+    }
+    if(!error_.empty()) {
+        munmap(memory, bytes);
+        return false;
+    }
+
+    header_ = header;
+    slots_ = ShmLayout::slots(header_);
+    mapped_bytes_ = bytes;
+    mask_ = header_->capacity - 1;
+
+    const uint64_t published = header_->write_seq.load(memory_order_acquire);
+    cursor_ = published;
+    if(from_oldest) {
+        cursor_ = published > header_->capacity ? published - header_->capacity : 0;
+    }
+
+    if(!registerReader()) {
+        error_ = name + ": all " + to_string(ShmLayout::MAX_READERS) + " reader entries are in use";
+        munmap(header_, mapped_bytes_);
+        header_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool ShmReader::registerReader() {
+    const int32_t self = static_cast<int32_t>(getpid());
+
+    // A free entry first; failing that, one left behind by a reader that crashed.
+    for(int pass = 0; pass < 2 && !entry_; pass++) {
+        for(auto& entry : header_->readers) {
+            int32_t pid = entry.pid.load(memory_order_relaxed);
+            const bool claimable = (pass == 0) ? pid == 0 : (pid != 0 && !ShmLayout::processAlive(pid));
+            if(claimable && entry.pid.compare_exchange_strong(pid, self, memory_order_acq_rel)) {
+                entry_ = &entry;
+                break;
+            }
+        }
+    }
+    if(!entry_) return false;
+
+    entry_->cursor.store(cursor_, memory_order_relaxed);
+    entry_->lost.store(0, memory_order_relaxed);
+    return true;
+}
+
+const TelemetryFrame* ShmReader::peek() {
+    if(!header_) return nullptr;
+    if(pending_seq_ != 0) return &slots_[cursor_ & mask_].frame;
+
+    while(true) {
+        const uint64_t published = header_->write_seq.load(memory_order_acquire);
+        if(cursor_ >= published) return nullptr;
+        if(published - cursor_ > header_->capacity) skipTo(published - header_->capacity);
+
+        const ShmLayout::Slot& slot = slots_[cursor_ & mask_];
+        const uint64_t seq = slot.seq.load(memory_order_acquire);
+        if(seq == ShmLayout::publishedSeq(cursor_)) {
+            pending_seq_ = seq;
+            return &slot.frame;
+        }
+        // The writer lapped us between the two loads; that frame is gone.
+        skipTo(cursor_ + 1);
+    }
+}
+
+bool ShmReader::advance() {
+    if(pending_seq_ == 0) return false;
+
+    // Orders the caller's reads of the frame before the re-check of its sequence.
+    atomic_thread_fence(memory_order_acquire);
+    const bool intact = slots_[cursor_ & mask_].seq.load(memory_order_relaxed) == pending_seq_;
+    pending_seq_ = 0;
+    if(!intact) lost_++;
+    cursor_++;
+
+    entry_->cursor.store(cursor_, memory_order_relaxed);
+    entry_->lost.store(lost_, memory_order_relaxed);
+    return intact;
+}
+
+bool ShmReader::read(TelemetryFrame& out) {
+    while(const TelemetryFrame* frame = peek()) {
+        out = *frame;
+        if(advance()) return true;
+    }
+    return false;
+}
+
+bool ShmReader::finished() const {
+    if(!header_) return true;
+    // write_seq is final once closed is seen, since the writer stores it first.
+    return header_->closed.load(memory_order_acquire) != 0
+        && cursor_ >= header_->write_seq.load(memory_order_acquire);
+}
+
+bool ShmReader::writerAlive() const {
+    return header_ && ShmLayout::processAlive(header_->writer_pid);
+}
+
+void ShmReader::skipTo(uint64_t seq) {
+    lost_ += seq - cursor_;
+    cursor_ = seq;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "ShmLayout.h"
+#include <string>
+
+// Reader side of the shared-memory ring, for consumer processes. Frames are used in
+// place, without copying them out of the segment:
+//
+//     ShmReader reader;
+//     if(!reader.attach("/f1-telemetry")) { ... reader.error() ... }
+//     while(!reader.finished()) {
+//         const TelemetryFrame* frame = reader.peek();
+//         if(!frame) { wait; continue; }
+//         ... use *frame ...
+//         if(!reader.advance()) { ... the frame was overwritten while in use: discard ... }
+//     }
+//
+// Each reader keeps its own cursor, so readers never block each other or the writer.
+// A reader that falls a whole ring behind skips to the oldest frame still available
+// and counts the rest in lost().
+class ShmReader {
+public:
+    ShmReader() = default;
+    ~ShmReader();
+
+    ShmReader(const ShmReader&) = delete;
+    ShmReader& operator=(const ShmReader&) = delete;
+
+    // Maps the segment and registers this reader, starting at the next frame
+    // published (or at the oldest still held if `from_oldest`). False with error()
+    // set if there is no compatible writer or every reader entry is taken.
+    bool attach(const std::string& name, bool from_oldest = false);
+
+    // The next frame, in place in the segment; nullptr if none has been published.
+    // The pointer stays usable until advance().
+    const TelemetryFrame* peek();
+    // Moves past the frame from peek(). False if the writer overwrote it while it
+    // was in use, in which case anything derived from it must be discarded.
+    bool advance();
+
+    // Copying read: waits for nothing, returns false if no frame is available.
+    bool read(TelemetryFrame& out);
+
+    // The writer closed the stream and every frame has been read.
+    bool finished() const;
+    // False once the writer process has exited without closing the stream.
+    bool writerAlive() const;
+
+    uint64_t lost() const { return lost_; }
+    uint32_t driverCount() const { return header_ ? header_->driver_count : 0; }
+    const std::string& error() const { return error_; }
+
+private:
+    std::string error_;
+    ShmLayout::Header* header_ = nullptr;
+    const ShmLayout::Slot* slots_ = nullptr;
+    ShmLayout::ReaderEntry* entry_ = nullptr;
+    size_t mapped_bytes_ = 0;
+    uint64_t mask_ = 0;
+    uint64_t cursor_ = 0;
+    uint64_t pending_seq_ = 0;   // slot sequence seen by peek(), 0 if none pending
+    uint64_t lost_ = 0;
+
+    bool registerReader();
+    void skipTo(uint64_t seq);
+};
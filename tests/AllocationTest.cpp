@@ -0,0 +1,111 @@
+#include "../src/telemetry/TelemetryGenerator.h"
+#include "../src/display/Leaderboard.h"
+#include "../src/data/season_data.h"
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <new>
+#include <streambuf>
+#include <ostream>
+#include <vector>
+
+namespace {
+    thread_local uint64_t thread_allocations = 0;
+}
+
+// Counting allocator: the tests below fail if a steady-state tick touches the heap.
+void* operator new(size_t size) {
+    thread_allocations++;
+    if(void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    thread_allocations++;
+    if(void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Formats everything and keeps none of it, so redraws run their full path.
+class DiscardBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+constexpr uint32_t WARMUP_TICKS = 300;
+constexpr uint32_t STEADY_TICKS = 1000;
+
+} // namespace
+
+// The live race's producer and leaderboard: generator.next() into a reused buffer,
+// then every frame through the board, redrawing whenever a tick completes.
+TEST(Allocation, LiveTickAndLeaderboardRefresh) {
+    const auto& profiles = SeasonData::builtin();
+    const TrackProfile& track = profiles->tracks()[0];
+    auto penalties = std::make_shared<PenaltyEnforcer>(profiles->drivers().size());
+    TelemetryGenerator generator(track, profiles, 52, penalties);
+    TrackLimitsMonitor track_limits(track, profiles, penalties, 1);
+    RaceAnalytics analytics(generator.driverCount(), track.sectors);
+    PipelineStats stats;
+    Leaderboard board(profiles, profiles->defaultGrid(), track, 52, analytics, track_limits, penalties, &stats);
+
+    DiscardBuffer discard;
+    std::ostream out(&discard);
+    std::vector<TelemetryFrame> frames(generator.driverCount());
+
+    // Warm-up: the first laps fill the analytics, so redraws show lap times too.
+    for(uint32_t t = 0; t < WARMUP_TICKS; t++) {
+        generator.next(frames);
+        for(const auto& frame : frames) {
+            analytics.processFrame(frame);
+            if(board.update(frame)) board.render(out);
+        }
+    }
+
+    uint32_t redraws = 0;
+    const uint64_t before = thread_allocations;
+    for(uint32_t t = 0; t < STEADY_TICKS; t++) {
+        generator.next(frames);
+        for(const auto& frame : frames) {
+            if(board.update(frame)) {
+                board.render(out);
+                redraws++;
+            }
+        }
+    }
+    const uint64_t allocations = thread_allocations - before;
+
+    ASSERT_FALSE(generator.isRaceFinished());
+    EXPECT_EQ(redraws, STEADY_TICKS);
+    EXPECT_EQ(allocations, 0u) << "over " << STEADY_TICKS << " steady-state ticks";
+}
+
+// A large multi-class grid takes the same allocation-free path.
+TEST(Allocation, LargeGridTick) {
+    const auto& profiles = SeasonData::builtin();
+    std::vector<GridEntry> grid(1000);
+    for(size_t i = 0; i < grid.size(); i++) {
+        grid[i].driver_index = static_cast<uint32_t>(i % profiles->drivers().size());
+        grid[i].car_index = static_cast<uint32_t>(i % profiles->cars().size());
+        grid[i].car_class = static_cast<uint8_t>(i * 3 / grid.size());
+    }
+    auto penalties = std::make_shared<PenaltyEnforcer>(grid.size());
+    TelemetryGenerator generator(profiles->tracks()[0], profiles, grid, 1'000'000, penalties);
+    std::vector<TelemetryFrame> frames(generator.driverCount());
+
+    for(uint32_t t = 0; t < WARMUP_TICKS; t++) {
+        generator.next(frames);
+    }
+    const uint64_t before = thread_allocations;
+    for(uint32_t t = 0; t < STEADY_TICKS; t++) {
+        generator.next(frames);
+    }
+    EXPECT_EQ(thread_allocations - before, 0u) << "over " << STEADY_TICKS << " steady-state ticks";
+}
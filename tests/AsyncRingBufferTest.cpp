@@ -0,0 +1,110 @@
+#include "../src/ingestion/AsyncRingBuffer.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+
+namespace {
+
+Task produce(AsyncRingBuffer<int>& out, int first, int count, std::atomic<int>& live) {
+    for(int i = first; i < first + count; i++) {
+        if(!co_await out.push(i)) break;
+    }
+    if(live.fetch_sub(1) == 1) out.close();
+}
+
+Task collect(AsyncRingBuffer<int>& in, std::vector<int>& seen) {
+    int value;
+    while(co_await in.pop(value)) {
+        seen.push_back(value);
+    }
+}
+
+Task pushOnce(AsyncRingBuffer<int>& out, int value, int& result) {
+    result = (co_await out.push(value)) ? 1 : 0;
+}
+
+Task popOnce(AsyncRingBuffer<int>& in, int& result) {
+    int value;
+    result = (co_await in.pop(value)) ? 1 : 0;
+}
+
+Task closeAfter(Executor& executor, AsyncRingBuffer<int>& ring) {
+    co_await executor.sleepFor(std::chrono::milliseconds(5));
+    ring.close();
+}
+
+} // namespace
+
+TEST(AsyncRingBuffer, DeliversInOrderThroughASmallRing) {
+    Executor executor(2);
+    AsyncRingBuffer<int> ring(4, executor);
+    std::atomic<int> live{1};
+    std::vector<int> seen;
+    executor.spawn(collect(ring, seen));
+    executor.spawn(produce(ring, 0, 10000, live));
+    executor.run();
+
+    ASSERT_EQ(seen.size(), 10000u);
+    for(int i = 0; i < 10000; i++) {
+        ASSERT_EQ(seen[i], i);
+    }
+}
+
+TEST(AsyncRingBuffer, ManyWritersLoseNothing) {
+    constexpr int WRITERS = 4;
+    constexpr int ITEMS = 5000;
+    Executor executor(3);
+    AsyncRingBuffer<int> ring(8, executor);
+    std::atomic<int> live{WRITERS};
+    std::vector<int> seen;
+    executor.spawn(collect(ring, seen));
+    for(int w = 0; w < WRITERS; w++) {
+        executor.spawn(produce(ring, w * ITEMS, ITEMS, live));
+    }
+    executor.run();
+
+    ASSERT_EQ(seen.size(), static_cast<size_t>(WRITERS * ITEMS));
+    // Each writer's items stay in its own order.
+    std::vector<int> last(WRITERS, -1);
+    for(int v : seen) {
+        EXPECT_GT(v, last[v / ITEMS]);
+        last[v / ITEMS] = v;
+    }
+}
+
+TEST(AsyncRingBuffer, CloseDrainsBufferedItemsFirst) {
+    Executor executor(1);
+    AsyncRingBuffer<int> ring(8, executor);
+    std::atomic<int> live{1};
+    executor.spawn(produce(ring, 0, 5, live));
+    executor.run();
+
+    std::vector<int> seen;
+    executor.spawn(collect(ring, seen));
+    executor.run();
+    EXPECT_EQ(seen, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(AsyncRingBuffer, CloseReleasesWaitingReaders) {
+    Executor executor(2);
+    AsyncRingBuffer<int> ring(4, executor);
+    int first = -1, second = -1;
+    executor.spawn(popOnce(ring, first));
+    executor.spawn(popOnce(ring, second));
+    executor.spawn(closeAfter(executor, ring));
+    executor.run();
+    EXPECT_EQ(first, 0);
+    EXPECT_EQ(second, 0);
+}
+
+TEST(AsyncRingBuffer, CloseReleasesWaitingWriters) {
+    Executor executor(2);
+    AsyncRingBuffer<int> ring(1, executor);
+    int stored = -1, waiting = -1;
+    executor.spawn(pushOnce(ring, 1, stored));
+    executor.spawn(pushOnce(ring, 2, waiting));
+    executor.spawn(closeAfter(executor, ring));
+    executor.run();
+    EXPECT_EQ(stored + waiting, 1);
+    EXPECT_EQ(ring.size(), 1u);
+}
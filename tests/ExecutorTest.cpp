@@ -0,0 +1,103 @@
+#include "../src/runtime/Executor.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <set>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+Task count(std::atomic<int>& counter) {
+    counter++;
+    co_return;
+}
+
+Task sleepThenCount(Executor& executor, std::chrono::milliseconds delay, std::atomic<int>& counter) {
+    co_await executor.sleepFor(delay);
+    counter++;
+}
+
+Task spawnChildren(Executor& executor, int children, std::atomic<int>& counter) {
+    for(int i = 0; i < children; i++) {
+        executor.spawn(count(counter));
+    }
+    co_return;
+}
+
+// Records each executor thread it runs on by hopping through short sleeps.
+Task recordThreads(Executor& executor, std::mutex& mutex, std::set<std::thread::id>& threads) {
+    for(int i = 0; i < 50; i++) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        }
+        co_await executor.sleepFor(std::chrono::microseconds(100));
+    }
+}
+
+Task hold(std::shared_ptr<int> held) {
+    co_return;
+}
+
+} // namespace
+
+TEST(Executor, RunReturnsOnceEveryTaskHasFinished) {
+    Executor executor(2);
+    std::atomic<int> counter{0};
+    for(int i = 0; i < 100; i++) {
+        executor.spawn(count(counter));
+    }
+    executor.run();
+    EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(Executor, TasksCanSpawnTasks) {
+    Executor executor(3);
+    std::atomic<int> counter{0};
+    executor.spawn(spawnChildren(executor, 50, counter));
+    executor.run();
+    EXPECT_EQ(counter.load(), 50);
+}
+
+TEST(Executor, SleepResumesAfterTheDelay) {
+    Executor executor(2);
+    std::atomic<int> counter{0};
+    const auto start = std::chrono::steady_clock::now();
+    executor.spawn(sleepThenCount(executor, std::chrono::milliseconds(20), counter));
+    executor.spawn(sleepThenCount(executor, std::chrono::milliseconds(5), counter));
+    executor.run();
+    EXPECT_EQ(counter.load(), 2);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+TEST(Executor, ThreadInitRunsOnEveryThread) {
+    Executor executor(3);
+    std::mutex mutex;
+    std::set<size_t> initialized;
+    executor.setThreadInit([&](size_t index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        initialized.insert(index);
+    });
+    std::set<std::thread::id> threads;
+    for(int i = 0; i < 4; i++) {
+        executor.spawn(recordThreads(executor, mutex, threads));
+    }
+    executor.run();
+    EXPECT_EQ(initialized, (std::set<size_t>{0, 1, 2}));
+    EXPECT_LE(threads.size(), 3u);
+}
+
+// Tasks still owned by the executor when it goes (here: never run) are destroyed
+// along with what their frames hold.
+TEST(Executor, DestroysUnfinishedTasks) {
+    auto held = std::make_shared<int>(0);
+    {
+        Executor executor(1);
+        executor.spawn(hold(held));
+        executor.spawn(hold(held));
+        EXPECT_EQ(held.use_count(), 3);
+    }
+    EXPECT_EQ(held.use_count(), 1);
+}
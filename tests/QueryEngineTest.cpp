@@ -0,0 +1,103 @@
+#include "../src/query/QueryEngine.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <vector>
+
+namespace {
+
+// Deterministic synthetic race: 20 drivers over enough laps to fill several chunks,
+// with speed rising by lap so zone maps can prune early chunks.
+std::vector<TelemetryFrame> syntheticFrames() {
+    std::vector<TelemetryFrame> frames;
+    for(uint32_t lap = 0; lap < 30; lap++) {
+        for(uint32_t step = 0; step < 30; step++) {
+            for(uint32_t d = 0; d < 20; d++) {
+                TelemetryFrame f{};
+                f.driver_id = d;
+                f.lap = lap;
+                f.sector = static_cast<uint8_t>(1 + step / 10);
+                f.speed_kph = 100.0f + lap * 5.0f + static_cast<float>((d * 7 + step * 3) % 40);
+                f.tire_wear = static_cast<float>((lap % 20) * 5 + d % 5) / 100.0f;
+                f.race_position = d + 1;
+                frames.push_back(f);
+            }
+        }
+    }
+    return frames;
+}
+
+struct QueryEngineTest : ::testing::Test {
+    std::vector<TelemetryFrame> frames = syntheticFrames();
+    TelemetryTable table;
+
+    void SetUp() override { table.append(frames); }
+};
+
+} // namespace
+
+TEST_F(QueryEngineTest, TableKeepsEveryRow) {
+    EXPECT_EQ(table.rowCount(), frames.size());
+    EXPECT_EQ(table.chunkCount(), (frames.size() + TelemetryTable::CHUNK_ROWS - 1) / TelemetryTable::CHUNK_ROWS);
+    EXPECT_FLOAT_EQ(table.zone(Column::DRIVER_ID).max, 19.0f);
+}
+
+TEST_F(QueryEngineTest, FilteredCountMatchesARowLoop) {
+    const Query query{{{Column::TIRE_WEAR, CompareOp::GT, 0.7f}, {Column::SPEED, CompareOp::GE, 200.0f}},
+                      Aggregate::COUNT, Column::SPEED, GroupBy::NONE};
+    uint64_t expected = 0;
+    for(const auto& f : frames) {
+        if(f.tire_wear > 0.7f && f.speed_kph >= 200.0f) expected++;
+    }
+
+    const QueryResult result = QueryEngine().run(table, query);
+    ASSERT_EQ(result.groups.size(), 1u);
+    EXPECT_EQ(result.groups[0].count, expected);
+    EXPECT_EQ(result.rows_matched, expected);
+}
+
+TEST_F(QueryEngineTest, GroupedMaxMatchesARowLoop) {
+    const Query query{{}, Aggregate::MAX, Column::SPEED, GroupBy::DRIVER_LAP};
+    std::map<std::pair<uint32_t, uint32_t>, float> expected;
+    for(const auto& f : frames) {
+        auto [it, inserted] = expected.try_emplace({f.driver_id, f.lap}, f.speed_kph);
+        if(!inserted && f.speed_kph > it->second) it->second = f.speed_kph;
+    }
+
+    const QueryResult result = QueryEngine().run(table, query);
+    ASSERT_EQ(result.groups.size(), expected.size());
+    for(const auto& g : result.groups) {
+        EXPECT_FLOAT_EQ(static_cast<float>(g.value), expected.at({g.driver_id, g.lap}));
+    }
+}
+
+TEST_F(QueryEngineTest, ZoneMapsSkipChunksThatCannotMatch) {
+    // Only the last laps are this fast, so the early chunks are pruned.
+    const Query query{{{Column::SPEED, CompareOp::GT, 260.0f}}, Aggregate::COUNT, Column::SPEED, GroupBy::NONE};
+    const QueryResult result = QueryEngine().run(table, query);
+    EXPECT_GT(result.chunks_skipped, 0u);
+    EXPECT_EQ(result.chunks_scanned + result.chunks_skipped, table.chunkCount());
+}
+
+TEST_F(QueryEngineTest, ParallelScanMatchesSerial) {
+    const Query query{{{Column::SECTOR, CompareOp::EQ, 2.0f}}, Aggregate::MEAN, Column::SPEED, GroupBy::DRIVER};
+    const QueryResult serial = QueryEngine().run(table, query);
+    const QueryResult parallel = QueryEngine(std::make_shared<ForkJoinPool>(3)).run(table, query);
+
+    ASSERT_EQ(serial.groups.size(), parallel.groups.size());
+    for(size_t i = 0; i < serial.groups.size(); i++) {
+        EXPECT_EQ(serial.groups[i].driver_id, parallel.groups[i].driver_id);
+        EXPECT_EQ(serial.groups[i].count, parallel.groups[i].count);
+        EXPECT_NEAR(serial.groups[i].value, parallel.groups[i].value, 1e-6 * serial.groups[i].value);
+    }
+}
+
+TEST_F(QueryEngineTest, SelectReturnsMatchingRowIds) {
+    const std::vector<Predicate> where{{Column::DRIVER_ID, CompareOp::EQ, 3.0f}, {Column::LAP, CompareOp::LT, 2.0f}};
+    const std::vector<uint64_t> rows = QueryEngine().select(table, where);
+
+    std::vector<uint64_t> expected;
+    for(uint64_t i = 0; i < frames.size(); i++) {
+        if(frames[i].driver_id == 3 && frames[i].lap < 2) expected.push_back(i);
+    }
+    EXPECT_EQ(rows, expected);
+}
@@ -0,0 +1,124 @@
+#include "../src/ingestion/RingBuffer.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(RingBuffer, PopsInPushOrder) {
+    RingBuffer<int> ring(4);
+    EXPECT_TRUE(ring.push(1));
+    EXPECT_TRUE(ring.push(2));
+    EXPECT_TRUE(ring.push(3));
+    EXPECT_EQ(ring.size(), 3u);
+
+    int value = 0;
+    for(int expected = 1; expected <= 3; expected++) {
+        ASSERT_TRUE(ring.pop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_EQ(ring.size(), 0u);
+}
+
+TEST(RingBuffer, PushFailsWhenFull) {
+    // One slot is kept free to tell full from empty.
+    RingBuffer<int> ring(4);
+    EXPECT_TRUE(ring.push(1));
+    EXPECT_TRUE(ring.push(2));
+    EXPECT_TRUE(ring.push(3));
+    EXPECT_FALSE(ring.push(4));
+
+    int value = 0;
+    ASSERT_TRUE(ring.pop(value));
+    EXPECT_TRUE(ring.push(4));
+}
+
+TEST(RingBuffer, TryPopDoesNotWait) {
+    RingBuffer<int> ring(4);
+    int value = 0;
+    EXPECT_FALSE(ring.tryPop(value));
+    ring.push(7);
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 7);
+}
+
+TEST(RingBuffer, ShutdownDrainsThenEnds) {
+    RingBuffer<int> ring(8);
+    ring.push(1);
+    ring.push(2);
+    ring.shutdown();
+
+    EXPECT_FALSE(ring.push(3));
+    int value = 0;
+    ASSERT_TRUE(ring.pop(value));
+    EXPECT_EQ(value, 1);
+    ASSERT_TRUE(ring.pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_FALSE(ring.pop(value));
+}
+
+TEST(RingBuffer, ShutdownWakesBlockedConsumers) {
+    RingBuffer<int> ring(8);
+    std::atomic<int> ended{0};
+    std::vector<std::thread> consumers;
+    for(int i = 0; i < 3; i++) {
+        consumers.emplace_back([&]() {
+            int value;
+            while(ring.pop(value)) {}
+            ended++;
+        });
+    }
+    ring.shutdown();
+    for(auto& t : consumers) t.join();
+    EXPECT_EQ(ended.load(), 3);
+}
+
+// Every item from every producer is popped exactly once, and each producer's items
+// come out in the order it pushed them.
+TEST(RingBuffer, ManyProducersAndConsumersLoseNothing) {
+    constexpr int PRODUCERS = 4;
+    constexpr int CONSUMERS = 3;
+    constexpr int ITEMS = 20000;
+
+    struct Item {
+        int producer;
+        int seq;
+    };
+    RingBuffer<Item> ring(64);
+
+    std::vector<std::vector<int>> seen(CONSUMERS * PRODUCERS);
+    std::vector<std::thread> consumers;
+    for(int c = 0; c < CONSUMERS; c++) {
+        consumers.emplace_back([&, c]() {
+            Item item;
+            while(ring.pop(item)) {
+                seen[c * PRODUCERS + item.producer].push_back(item.seq);
+            }
+        });
+    }
+    std::vector<std::thread> producers;
+    for(int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([&, p]() {
+            for(int i = 0; i < ITEMS; i++) {
+                while(!ring.push({p, i})) std::this_thread::yield();
+            }
+        });
+    }
+    for(auto& t : producers) t.join();
+    ring.shutdown();
+    for(auto& t : consumers) t.join();
+
+    for(int p = 0; p < PRODUCERS; p++) {
+        std::vector<int> all;
+        for(int c = 0; c < CONSUMERS; c++) {
+            const auto& part = seen[c * PRODUCERS + p];
+            EXPECT_TRUE(std::is_sorted(part.begin(), part.end())) << "producer " << p << ", consumer " << c;
+            all.insert(all.end(), part.begin(), part.end());
+        }
+        std::sort(all.begin(), all.end());
+        ASSERT_EQ(all.size(), static_cast<size_t>(ITEMS)) << "producer " << p;
+        for(int i = 0; i < ITEMS; i++) {
+            ASSERT_EQ(all[i], i) << "producer " << p;
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#include "../src/transport/ShmPublisher.h"
+#include "../src/transport/ShmReader.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+std::string ringName(const char* test) {
+    return std::string("/f1-test-") + test + "-" + std::to_string(getpid());
+}
+
+std::vector<TelemetryFrame> tick(uint64_t timestamp_ns, uint32_t drivers) {
+    std::vector<TelemetryFrame> frames(drivers, TelemetryFrame{});
+    for(uint32_t d = 0; d < drivers; d++) {
+        frames[d].driver_id = d;
+        frames[d].timestamp_ns = timestamp_ns;
+    }
+    return frames;
+}
+
+} // namespace
+
+TEST(ShmRing, ReaderSeesEveryFrameInOrder) {
+    const std::string name = ringName("order");
+    ShmPublisher publisher;
+    ASSERT_TRUE(publisher.open(name, 64, 4)) << publisher.error();
+    ShmReader reader;
+    ASSERT_TRUE(reader.attach(name)) << reader.error();
+    EXPECT_EQ(reader.driverCount(), 4u);
+
+    TelemetryFrame frame;
+    EXPECT_FALSE(reader.read(frame));
+
+    for(uint64_t t = 1; t <= 10; t++) {
+        publisher.publish(tick(t, 4));
+        for(uint32_t d = 0; d < 4; d++) {
+            ASSERT_TRUE(reader.read(frame));
+            EXPECT_EQ(frame.timestamp_ns, t);
+            EXPECT_EQ(frame.driver_id, d);
+        }
+    }
+    EXPECT_FALSE(reader.finished());
+    publisher.close();
+    EXPECT_TRUE(reader.finished());
+    EXPECT_EQ(reader.lost(), 0u);
+}
+
+TEST(ShmRing, LateReaderStartsAtTheNextFrameUnlessFromOldest) {
+    const std::string name = ringName("late");
+    ShmPublisher publisher;
+    ASSERT_TRUE(publisher.open(name, 64, 2)) << publisher.error();
+    publisher.publish(tick(1, 2));
+
+    ShmReader latest, oldest;
+    ASSERT_TRUE(latest.attach(name));
+    ASSERT_TRUE(oldest.attach(name, true));
+    publisher.publish(tick(2, 2));
+
+    TelemetryFrame frame;
+    ASSERT_TRUE(latest.read(frame));
+    EXPECT_EQ(frame.timestamp_ns, 2u);
+    ASSERT_TRUE(oldest.read(frame));
+    EXPECT_EQ(frame.timestamp_ns, 1u);
+}
+
+TEST(ShmRing, SlowReaderSkipsAheadAndCountsLoss) {
+    const std::string name = ringName("slow");
+    ShmPublisher publisher;
+    ASSERT_TRUE(publisher.open(name, 16, 1)) << publisher.error();
+    ShmReader reader;
+    ASSERT_TRUE(reader.attach(name));
+
+    for(uint64_t t = 1; t <= 40; t++) {
+        publisher.publish(tick(t, 1));
+    }
+    TelemetryFrame frame;
+    uint64_t read = 0;
+    uint64_t last = 0;
+    while(reader.read(frame)) {
+        EXPECT_GT(frame.timestamp_ns, last);
+        last = frame.timestamp_ns;
+        read++;
+    }
+    EXPECT_EQ(last, 40u);
+    EXPECT_GT(reader.lost(), 0u);
+    EXPECT_EQ(read + reader.lost(), 40u);
+}
+
+// A reader thread following a writer thread sees a gap-free, ordered stream as
+// long as it keeps up (the writer waits on the reported lag).
+TEST(ShmRing, ConcurrentReaderKeepsUp) {
+    const std::string name = ringName("concurrent");
+    ShmPublisher publisher;
+    ASSERT_TRUE(publisher.open(name, 256, 20)) << publisher.error();
+    ShmReader reader;
+    ASSERT_TRUE(reader.attach(name));
+
+    constexpr uint64_t TICKS = 500;
+    uint64_t frames_read = 0;
+    uint64_t out_of_order = 0;
+    std::thread consumer([&]() {
+        uint64_t last = 0;
+        while(!reader.finished()) {
+            const TelemetryFrame* frame = reader.peek();
+            if(!frame) {
+                std::this_thread::yield();
+                continue;
+            }
+            const uint64_t ts = frame->timestamp_ns;
+            if(reader.advance()) {
+                if(ts < last) out_of_order++;
+                last = ts;
+                frames_read++;
+            }
+        }
+    });
+
+    for(uint64_t t = 1; t <= TICKS; t++) {
+        publisher.publish(tick(t, 20));
+        while(publisher.readers().front().lag > 200) std::this_thread::yield();
+    }
+    publisher.close();
+    consumer.join();
+
+    EXPECT_EQ(frames_read, TICKS * 20);
+    EXPECT_EQ(out_of_order, 0u);
+    EXPECT_EQ(reader.lost(), 0u);
+}
@@ -0,0 +1,63 @@
+#include "../src/common/SimKernel.h"
+#include "../src/data/season_data.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+struct TimedState {
+    uint32_t lap = 0;
+    float tire_wear = 0.0f;
+    bool has_pitted = false;
+    bool is_on_pit = false;
+};
+
+struct InstantState {
+    uint32_t lap = 0;
+    float tire_wear = 0.0f;
+    bool has_pitted = false;
+};
+
+} // namespace
+
+TEST(SimKernelPitRule, PlannedStopIsTakenOnceOnItsLap) {
+    const DriverProfile& driver = SeasonData::builtin()->drivers()[0];
+    InstantState state;
+    state.tire_wear = 0.99f;   // a planned car ignores wear
+
+    state.lap = 11;
+    EXPECT_FALSE(SimKernel::shouldPit<SimKernel::InstantPit>(state, driver, 12));
+    state.lap = 12;
+    EXPECT_TRUE(SimKernel::shouldPit<SimKernel::InstantPit>(state, driver, 12));
+    EXPECT_TRUE(state.has_pitted);
+    EXPECT_FALSE(SimKernel::shouldPit<SimKernel::InstantPit>(state, driver, 12));
+}
+
+TEST(SimKernelPitRule, UnplannedCarsPitEveryTimeWearPassesTheThreshold) {
+    const DriverProfile& driver = SeasonData::builtin()->drivers()[0];
+    const float threshold = SimKernel::pitThreshold(driver);
+
+    // Both pit policies apply the same rule, so the strategy simulators and the
+    // live race model the same field.
+    InstantState instant;
+    TimedState timed;
+    for(int stop = 0; stop < 3; stop++) {
+        instant.tire_wear = timed.tire_wear = threshold - 0.01f;
+        EXPECT_FALSE(SimKernel::shouldPit<SimKernel::InstantPit>(instant, driver, SimKernel::NO_PLAN));
+        EXPECT_FALSE(SimKernel::shouldPit<SimKernel::TimedPit>(timed, driver, SimKernel::NO_PLAN));
+
+        instant.tire_wear = timed.tire_wear = threshold + 0.01f;
+        EXPECT_TRUE(SimKernel::shouldPit<SimKernel::InstantPit>(instant, driver, SimKernel::NO_PLAN)) << "stop " << stop;
+        EXPECT_TRUE(SimKernel::shouldPit<SimKernel::TimedPit>(timed, driver, SimKernel::NO_PLAN)) << "stop " << stop;
+    }
+}
+
+TEST(SimKernelPitRule, NoNewStopWhileInThePitLane) {
+    const DriverProfile& driver = SeasonData::builtin()->drivers()[0];
+    TimedState state;
+    state.is_on_pit = true;
+    state.tire_wear = 1.0f;
+    state.lap = 5;
+    EXPECT_FALSE(SimKernel::shouldPit<SimKernel::TimedPit>(state, driver, SimKernel::NO_PLAN));
+    EXPECT_FALSE(SimKernel::shouldPit<SimKernel::TimedPit>(state, driver, 5));
+    EXPECT_FALSE(state.has_pitted);
+}
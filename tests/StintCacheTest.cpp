@@ -0,0 +1,158 @@
+#include "../src/strategy/StintCache.h"
+#include "../src/data/ProfileTable.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+StintKey key(uint32_t driver, uint16_t start_lap, uint16_t length, uint16_t wear = 0, uint32_t track = 1, uint32_t profiles = 1) {
+    StintKey k{};
+    k.driver_id = driver;
+    k.profiles = profiles;
+    k.track = track;
+    k.start_lap = start_lap;
+    k.stint_length = length;
+    k.start_wear = wear;
+    return k;
+}
+
+// A value that can be recomputed from its key, to spot results stored under the wrong key.
+StintResult valueFor(const StintKey& k) {
+    return {k.driver_id * 100000u + k.start_lap * 100u + k.stint_length, k.stint_length * 0.01f, k.start_wear * 0.001f};
+}
+
+} // namespace
+
+TEST(StintCache, MissThenHit) {
+    StintCache cache(1024);
+    StintResult out{};
+    EXPECT_EQ(cache.lookup(key(1, 5, 10), out), 0u);
+
+    cache.insert(key(1, 5, 10), valueFor(key(1, 5, 10)));
+    ASSERT_EQ(cache.lookup(key(1, 5, 10), out), 10u);
+    EXPECT_EQ(out.ticks, valueFor(key(1, 5, 10)).ticks);
+
+    const auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.inserts, 1u);
+}
+
+TEST(StintCache, LongestPrefixIsReturned) {
+    StintCache cache(1024);
+    cache.insert(key(2, 0, 4), valueFor(key(2, 0, 4)));
+    cache.insert(key(2, 0, 7), valueFor(key(2, 0, 7)));
+
+    StintResult out{};
+    ASSERT_EQ(cache.lookup(key(2, 0, 12), out), 7u);
+    EXPECT_EQ(out.ticks, valueFor(key(2, 0, 7)).ticks);
+    EXPECT_EQ(cache.stats().prefix_hits, 1u);
+
+    // A different start wear or lap is a different stint.
+    EXPECT_EQ(cache.lookup(key(2, 0, 12, 300), out), 0u);
+    EXPECT_EQ(cache.lookup(key(2, 1, 12), out), 0u);
+}
+
+TEST(StintCache, TracksDoNotShareStints) {
+    StintCache cache(1024);
+    cache.insert(key(4, 0, 10, 0, 1), valueFor(key(4, 0, 10)));
+
+    StintResult out{};
+    EXPECT_EQ(cache.lookup(key(4, 0, 10, 0, 2), out), 0u);
+    EXPECT_EQ(cache.lookup(key(4, 0, 10, 0, 1), out), 10u);
+
+    TrackProfile a{1, 3, 5.0f, 1.0f, 0.5f, 0.1f};
+    TrackProfile b = a;
+    b.track_id = 2;
+    TrackProfile c = a;
+    c.tire_wear_factor = 1.2f;
+    EXPECT_EQ(StintCache::trackKey(a), StintCache::trackKey(TrackProfile(a)));
+    EXPECT_NE(StintCache::trackKey(a), StintCache::trackKey(b));
+    EXPECT_NE(StintCache::trackKey(a), StintCache::trackKey(c));
+}
+
+TEST(StintCache, ProfileTablesDoNotShareStints) {
+    StintCache cache(1024);
+    cache.insert(key(4, 0, 10, 0, 1, 1), valueFor(key(4, 0, 10)));
+
+    StintResult out{};
+    EXPECT_EQ(cache.lookup(key(4, 0, 10, 0, 1, 2), out), 0u);
+    EXPECT_EQ(cache.lookup(key(4, 0, 10, 0, 1, 1), out), 10u);
+
+    // Even identical seasons parsed twice are told apart.
+    const char* season =
+        "team t \"Team\" T\n"
+        "driver \"Driver\" t 0.5 0.5 0.5 0.5\n"
+        "car t 0.9 0.9 0.9 0.9\n"
+        "track 1 3 5.0 1.0 0.5 0.1\n";
+    std::string error;
+    const auto a = ProfileTable::parse(season, error);
+    const auto b = ProfileTable::parse(season, error);
+    ASSERT_TRUE(a && b) << error;
+    EXPECT_NE(a->generation(), b->generation());
+}
+
+// Lookups only probe lengths up to the longest one inserted from that start.
+TEST(StintCache, LongestInsertedBoundsTheProbe) {
+    StintCache cache(1024);
+    for(uint16_t length = 1; length <= 5; length++) {
+        cache.insert(key(5, 2, length), valueFor(key(5, 2, length)));
+    }
+
+    StintResult out{};
+    ASSERT_EQ(cache.lookup(key(5, 2, 30), out), 5u);
+    EXPECT_EQ(out.ticks, valueFor(key(5, 2, 5)).ticks);
+    ASSERT_EQ(cache.lookup(key(5, 2, 3), out), 3u);
+    EXPECT_EQ(out.ticks, valueFor(key(5, 2, 3)).ticks);
+    EXPECT_EQ(cache.lookup(key(5, 3, 30), out), 0u);
+}
+
+TEST(StintCache, StaysWithinCapacity) {
+    StintCache cache(256);
+    // Every length of a start shares a stripe, so use enough starts to reach them all.
+    for(uint16_t lap = 0; lap < 2000; lap++) {
+        for(uint16_t length = 1; length <= 20; length++) {
+            cache.insert(key(3, lap, length), valueFor(key(3, lap, length)));
+        }
+    }
+    const auto stats = cache.stats();
+    EXPECT_EQ(stats.inserts, 40000u);
+    EXPECT_EQ(stats.inserts - stats.evictions, cache.capacity());
+}
+
+TEST(StintCache, WearQuantization) {
+    EXPECT_EQ(StintCache::quantizeWear(0.0f), 0u);
+    EXPECT_EQ(StintCache::quantizeWear(0.4567f), 457u);
+    EXPECT_EQ(StintCache::quantizeWear(2.0f), 1000u);
+    EXPECT_FLOAT_EQ(StintCache::wearOf(250), 0.25f);
+}
+
+// Workers inserting and looking up overlapping stints never see a value stored
+// under another key.
+TEST(StintCache, ConcurrentWorkersSeeConsistentValues) {
+    StintCache cache(2048);
+    std::vector<std::thread> workers;
+    std::vector<int> wrong(4, 0);
+    for(int w = 0; w < 4; w++) {
+        workers.emplace_back([&, w]() {
+            StintResult out{};
+            for(int i = 0; i < 20000; i++) {
+                const StintKey k = key(static_cast<uint32_t>(i % 20), static_cast<uint16_t>((i / 20) % 50),
+                                       static_cast<uint16_t>(1 + (i + w) % 15));
+                const uint32_t found = cache.lookup(k, out);
+                if(found > 0) {
+                    StintKey prefix = k;
+                    prefix.stint_length = static_cast<uint16_t>(found);
+                    if(out.ticks != valueFor(prefix).ticks) wrong[w]++;
+                } else {
+                    cache.insert(k, valueFor(k));
+                }
+            }
+        });
+    }
+    for(auto& t : workers) t.join();
+    for(int w = 0; w < 4; w++) {
+        EXPECT_EQ(wrong[w], 0) << "worker " << w;
+    }
+}
@@ -0,0 +1,104 @@
+#include "../src/race-control/TrackLimitsMonitor.h"
+#include "../src/data/season_data.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+// `size` slots cycling through the season's drivers and cars.
+std::vector<GridEntry> largeGrid(size_t size) {
+    const auto& profiles = SeasonData::builtin();
+    std::vector<GridEntry> grid(size);
+    for(size_t i = 0; i < size; i++) {
+        grid[i].driver_index = static_cast<uint32_t>(i % profiles->drivers().size());
+        grid[i].car_index = static_cast<uint32_t>(i % profiles->cars().size());
+        grid[i].car_class = static_cast<uint8_t>(i * 2 / size);
+    }
+    return grid;
+}
+
+SectorEvent event(uint32_t driver_id, uint32_t lap, uint8_t sector) {
+    SectorEvent e{};
+    e.driver_id = driver_id;
+    e.lap = lap;
+    e.sector = sector;
+    e.speed_kph = 250.0f;
+    e.tire_wear = 0.9f;
+    return e;
+}
+
+} // namespace
+
+// Slots past the season's driver count are tracked like any other and penalized
+// through the enforcer under their own id.
+TEST(TrackLimitsMonitor, TracksEveryGridSlot) {
+    const auto& profiles = SeasonData::builtin();
+    const auto grid = largeGrid(500);
+    auto penalties = std::make_shared<PenaltyEnforcer>(grid.size());
+    TrackLimitsMonitor monitor(profiles->tracks()[0], profiles, grid, penalties, 7);
+
+    for(uint32_t lap = 0; lap < 60; lap++) {
+        for(uint8_t sector = 1; sector <= 3; sector++) {
+            for(uint32_t id = 0; id < grid.size(); id++) {
+                monitor.processSectorEvent(event(id, lap, sector));
+            }
+        }
+    }
+
+    uint32_t penalized_beyond_profiles = 0;
+    for(uint32_t id = 0; id < grid.size(); id++) {
+        const TrackLimitsState state = monitor.getDriverState(id);
+        EXPECT_EQ(state.warnings, monitor.getWarnings(id));
+        EXPECT_EQ(state.violation_laps.size(), state.warnings);
+        EXPECT_EQ(state.has_penalty, state.warnings >= 3);
+        if(state.has_penalty) {
+            EXPECT_EQ(penalties->getPenaltyInfo(id).state, PenaltyState::PENDING);
+            if(id >= profiles->drivers().size()) penalized_beyond_profiles++;
+        }
+    }
+    EXPECT_GT(penalized_beyond_profiles, 0u);
+
+    const TrackLimitsSnapshot snapshot = monitor.snapshot();
+    EXPECT_EQ(snapshot.last_sector.size(), grid.size());
+    EXPECT_EQ(snapshot.violations.size(), grid.size());
+}
+
+// Violation odds follow the slot's driver profile, whichever slot it is in.
+TEST(TrackLimitsMonitor, TraitsComeFromTheSlotsDriver) {
+    const auto& profiles = SeasonData::builtin();
+    const auto& drivers = profiles->drivers();
+    uint32_t calmest = 0;
+    uint32_t wildest = 0;
+    for(uint32_t i = 0; i < drivers.size(); i++) {
+        if(drivers[i].aggression < drivers[calmest].aggression) calmest = i;
+        if(drivers[i].aggression > drivers[wildest].aggression) wildest = i;
+    }
+    ASSERT_LT(drivers[calmest].aggression, drivers[wildest].aggression);
+
+    // Half the slots hold the calmest driver, half the wildest; slow, fresh-tire
+    // sectors so aggression is the only factor.
+    std::vector<GridEntry> grid(400);
+    for(uint32_t i = 0; i < grid.size(); i++) {
+        grid[i] = {i < 200 ? calmest : wildest, i % static_cast<uint32_t>(profiles->cars().size()), 0};
+    }
+    auto penalties = std::make_shared<PenaltyEnforcer>(grid.size());
+    TrackLimitsMonitor monitor(profiles->tracks()[0], profiles, grid, penalties, 11);
+
+    for(uint32_t lap = 0; lap < 50; lap++) {
+        for(uint8_t sector = 1; sector <= 3; sector++) {
+            for(uint32_t id = 0; id < grid.size(); id++) {
+                SectorEvent e = event(id, lap, sector);
+                e.speed_kph = 150.0f;
+                e.tire_wear = 0.1f;
+                monitor.processSectorEvent(e);
+            }
+        }
+    }
+
+    uint64_t calm_warnings = 0;
+    uint64_t wild_warnings = 0;
+    for(uint32_t id = 0; id < grid.size(); id++) {
+        (id < 200 ? calm_warnings : wild_warnings) += monitor.getWarnings(id);
+    }
+    EXPECT_LT(calm_warnings, wild_warnings);
+}